@@ -0,0 +1,96 @@
+/*
+ * match_batch vs per-element let() on the simple_matching kernels
+ * Classifies the same int32 arrays both ways and reports cycles per element
+ */
+
+#include "bench.h"
+#include "../match.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ELEMENTS (1 << 16)
+#define ROUNDS 20
+
+static int32_t scores[ELEMENTS];
+static uint8_t let_out[ELEMENTS];
+static uint8_t batch_out[ELEMENTS];
+
+// Per-element classification, as in calculate_grade_match
+__attribute__((noinline)) void grade_let(const int32_t* in, size_t n, uint8_t* out) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = let(in[i]) in(
+            is(ge(90)) ? 0
+            : is(ge(80)) ? 1
+            : is(ge(70)) ? 2
+            : is(ge(60)) ? 3
+            : 4
+        );
+    }
+}
+
+__attribute__((noinline)) void grade_batch(const int32_t* in, size_t n, uint8_t* out) {
+    match_batch(in, n, out, ge(90), ge(80), ge(70), ge(60), __);
+}
+
+// Per-element classification, as in check_range_match
+__attribute__((noinline)) void range_let(const int32_t* in, size_t n, uint8_t* out) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = let(in[i]) in(
+            is(gt(50)) ? 0
+            : is(between(20, 30)) ? 1
+            : is(gt(10)) ? 2
+            : 3
+        );
+    }
+}
+
+__attribute__((noinline)) void range_batch(const int32_t* in, size_t n, uint8_t* out) {
+    match_batch(in, n, out, gt(50), between(20, 30), gt(10), __);
+}
+
+static void run(BenchSuite* suite, const char* name,
+                void (*per_element)(const int32_t*, size_t, uint8_t*),
+                void (*batch)(const int32_t*, size_t, uint8_t*)) {
+    char label[64];
+    snprintf(label, sizeof label, "%s/let", name);
+    BENCH(suite, label, (uint64_t)ELEMENTS * ROUNDS) {
+        for (int r = 0; r < ROUNDS; r++) per_element(scores, ELEMENTS, let_out);
+    }
+    double let_ticks = bench_last(suite)->ticks_per_op;
+    
+    snprintf(label, sizeof label, "%s/match_batch", name);
+    BENCH(suite, label, (uint64_t)ELEMENTS * ROUNDS) {
+        for (int r = 0; r < ROUNDS; r++) batch(scores, ELEMENTS, batch_out);
+    }
+    double batch_ticks = bench_last(suite)->ticks_per_op;
+    
+    for (int i = 0; i < ELEMENTS; i++) {
+        if (let_out[i] != batch_out[i]) {
+            printf("%s: mismatch at %d\n", name, i);
+            exit(1);
+        }
+    }
+    
+    printf("%-8s let: %6.3f %s/element | match_batch: %6.3f %s/element | speedup %5.2fx\n",
+           name, let_ticks, BENCH_TICK_UNIT, batch_ticks, BENCH_TICK_UNIT, let_ticks / batch_ticks);
+}
+
+int main() {
+    printf("=== Batch Classification Benchmark ===\n");
+    BenchSuite suite = bench_suite("batch_classify", NULL);
+#if MATCH_BATCH_X86
+    printf("Kernel: %s\n", __builtin_cpu_supports("avx2") ? "AVX2" :
+                           __builtin_cpu_supports("sse4.2") ? "SSE4.2" : "scalar");
+#else
+    printf("Kernel: scalar\n");
+#endif
+    
+    // Random input so the per-element arm chain can't be predicted
+    srand(42);
+    for (int i = 0; i < ELEMENTS; i++) scores[i] = rand() % 100;
+    
+    run(&suite, "grade", grade_let, grade_batch);
+    run(&suite, "range", range_let, range_batch);
+    
+    return bench_suite_end(&suite);
+}
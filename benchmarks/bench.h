@@ -0,0 +1,414 @@
+/*
+ * Shared benchmark harness for benchmarks/
+ *
+ * Each case runs a few warmup repetitions, then BENCH_REPS timed ones, and
+ * reports the median, p95, mean and standard deviation per operation. Wall
+ * time comes from CLOCK_MONOTONIC; on x86 the TSC is read alongside, so
+ * ticks are reference cycles there and nanoseconds elsewhere.
+ *
+ *   #include "bench.h"        // first: it selects POSIX clock_gettime
+ *   #include "../match.h"
+ *
+ *   BenchSuite suite = bench_suite("simple_matching", "match");
+ *   BENCH(&suite, "grade", ITERATIONS) {
+ *       for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(calculate_grade(i % 100));
+ *   }
+ *   return bench_suite_end(&suite);
+ *
+ * The body of BENCH runs once per repetition and should do `ops` operations.
+ * BENCH_DO_NOT_OPTIMIZE(x) makes the compiler produce x without storing it
+ * anywhere; BENCH_CLOBBER_MEMORY() makes it assume all memory was read and
+ * written. bench_last(&suite) returns the statistics of the latest case.
+ *
+ * On Linux each repetition is also counted with perf_event_open: cycles,
+ * instructions, branch misses and L1d read misses (user space only). The
+ * medians per operation are reported with the IPC. Without perf access
+ * (perf_event_paranoid, containers, virtual machines without a PMU) or off
+ * Linux the counters are reported as unavailable and timing goes on alone.
+ *
+ * Environment:
+ *   BENCH_REPS    timed repetitions per case (default 15, at most 1000)
+ *   BENCH_WARMUP  untimed repetitions first (default 2)
+ *   BENCH_JSON    also append one JSON object per case to this file
+ *   BENCH_PERF    0 to skip the hardware counters
+ *
+ * Each JSON line carries the suite, variant, case, compiler and the
+ * statistics, so results from different compilers can be collected side by
+ * side; counters that could not be read are null. Define BENCH_FLAGS as a
+ * string to record the compiler flags too.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE   // syscall()
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_TICK_UNIT "cycles"
+static inline uint64_t bench_ticks(void) { return __rdtsc(); }
+#else
+#define BENCH_TICK_UNIT "ns"
+static inline uint64_t bench_ticks(void);
+#endif
+
+#define BENCH_MAX_REPS 1000
+#define BENCH_MAX_CASES 64
+
+#if defined(__clang__)
+#define BENCH_COMPILER "clang " __clang_version__
+#elif defined(__GNUC__)
+#define BENCH_COMPILER "gcc " __VERSION__
+#else
+#define BENCH_COMPILER "unknown"
+#endif
+
+#ifndef BENCH_FLAGS
+#define BENCH_FLAGS ""
+#endif
+
+static inline uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#if !defined(__x86_64__) && !defined(__i386__)
+static inline uint64_t bench_ticks(void) { return bench_now_ns(); }
+#endif
+
+/* ========================================================================
+ * Hardware counters
+ * ======================================================================== */
+
+enum { BENCH_CYCLES, BENCH_INSTRUCTIONS, BENCH_BRANCH_MISSES, BENCH_L1D_MISSES, BENCH_COUNTERS };
+
+static const char *const bench_counter_names[BENCH_COUNTERS] = {
+    "cycles", "instructions", "branch_misses", "l1d_misses"
+};
+
+typedef struct {
+    int fd[BENCH_COUNTERS];    // -1 when the counter could not be opened
+    int slot[BENCH_COUNTERS];  // position in the group read
+    int open;                  // number of counters in the group
+    uint64_t enabled, running; // group times so far; RESET leaves them alone
+    char why[96];              // set when no counter could be opened
+} BenchPerf;
+
+#if defined(__linux__)
+
+static int bench_perf_open(BenchPerf *perf, int counter, uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof attr);
+    attr.size = sizeof attr;
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = perf->open == 0;   // the leader starts and stops the group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    int leader = perf->open ? perf->fd[BENCH_CYCLES] : -1;
+    int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+    if (fd < 0) return errno;
+    perf->fd[counter] = fd;
+    perf->slot[counter] = perf->open++;
+    return 0;
+}
+
+static void bench_perf_init(BenchPerf *perf) {
+    for (int i = 0; i < BENCH_COUNTERS; i++) perf->fd[i] = -1;
+    perf->open = 0;
+    perf->enabled = perf->running = 0;
+    perf->why[0] = 0;
+    const char *env = getenv("BENCH_PERF");
+    if (env && strcmp(env, "0") == 0) {
+        snprintf(perf->why, sizeof perf->why, "disabled by BENCH_PERF=0");
+        return;
+    }
+    // Without cycles there is no group; the others are optional
+    int err = bench_perf_open(perf, BENCH_CYCLES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    if (err) {
+        snprintf(perf->why, sizeof perf->why, "perf_event_open: %s", strerror(err));
+        return;
+    }
+    bench_perf_open(perf, BENCH_INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    bench_perf_open(perf, BENCH_BRANCH_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    bench_perf_open(perf, BENCH_L1D_MISSES, PERF_TYPE_HW_CACHE,
+                    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+}
+
+static inline void bench_perf_start(BenchPerf *perf) {
+    if (!perf->open) return;
+    ioctl(perf->fd[BENCH_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(perf->fd[BENCH_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+// Stops the group and stores each counter, scaled up if it was multiplexed
+static inline void bench_perf_stop(BenchPerf *perf, double out[BENCH_COUNTERS]) {
+    if (!perf->open) return;
+    ioctl(perf->fd[BENCH_CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    uint64_t buf[3 + BENCH_COUNTERS];   // nr, time_enabled, time_running, values
+    ssize_t got = read(perf->fd[BENCH_CYCLES], buf, sizeof buf);
+    if (got <= 0) buf[1] = perf->enabled, buf[2] = perf->running;
+    uint64_t enabled = buf[1] - perf->enabled, running = buf[2] - perf->running;
+    perf->enabled = buf[1];
+    perf->running = buf[2];
+    double scale = running ? (double)enabled / (double)running : 0.0;
+    for (int i = 0; i < BENCH_COUNTERS; i++)
+        out[i] = perf->fd[i] >= 0 && scale > 0.0 ? (double)buf[3 + perf->slot[i]] * scale : -1.0;
+}
+
+static void bench_perf_close(BenchPerf *perf) {
+    for (int i = BENCH_COUNTERS - 1; i >= 0; i--) {
+        if (perf->fd[i] >= 0) close(perf->fd[i]);
+        perf->fd[i] = -1;
+    }
+    perf->open = 0;
+}
+
+#else
+
+static void bench_perf_init(BenchPerf *perf) {
+    for (int i = 0; i < BENCH_COUNTERS; i++) perf->fd[i] = -1;
+    perf->open = 0;
+    snprintf(perf->why, sizeof perf->why, "perf_event_open needs Linux");
+}
+static inline void bench_perf_start(BenchPerf *perf) { (void)perf; }
+static inline void bench_perf_stop(BenchPerf *perf, double out[BENCH_COUNTERS]) { (void)perf; (void)out; }
+static void bench_perf_close(BenchPerf *perf) { (void)perf; }
+
+#endif
+
+// The value must be computed, but it is not stored or otherwise used
+#define BENCH_DO_NOT_OPTIMIZE(x) \
+    do { __typeof__(x) __bench_value = (x); __asm__ volatile("" : : "r,m"(__bench_value) : "memory"); } while (0)
+
+#define BENCH_CLOBBER_MEMORY() __asm__ volatile("" : : : "memory")
+
+typedef struct {
+    char name[64];
+    uint64_t ops;
+    int reps;
+    double median_ns, p95_ns, mean_ns, stddev_ns, min_ns;   // per repetition
+    double ns_per_op, p95_ns_per_op;
+    double ticks_per_op;                                    // median, in BENCH_TICK_UNIT
+    double per_op[BENCH_COUNTERS];                          // median counts, -1 if unavailable
+    double ipc;                                             // -1 if unavailable
+} BenchStats;
+
+typedef struct {
+    const char *suite;
+    const char *variant;
+    int reps, warmup;
+    FILE *json;
+    BenchPerf perf;
+    int ncases;
+    double total_median_ns;
+    BenchStats cases[BENCH_MAX_CASES];
+} BenchSuite;
+
+typedef struct {
+    BenchSuite *suite;
+    const char *name;
+    uint64_t ops;
+    int iteration;         // warmups first, then timed repetitions
+    uint64_t start_ns, start_ticks;
+    double ns[BENCH_MAX_REPS];
+    double ticks[BENCH_MAX_REPS];
+    double counts[BENCH_COUNTERS][BENCH_MAX_REPS];
+} BenchRun;
+
+static int bench_env_int(const char *name, int fallback, int lo, int hi) {
+    const char *s = getenv(name);
+    if (!s || !*s) return fallback;
+    int v = atoi(s);
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+// variant tells apart implementations of the same suite ("handwritten",
+// "match"); NULL when a single program compares them itself
+static inline BenchSuite bench_suite(const char *suite, const char *variant) {
+    BenchSuite s = { .suite = suite, .variant = variant };
+    s.reps = bench_env_int("BENCH_REPS", 15, 1, BENCH_MAX_REPS);
+    s.warmup = bench_env_int("BENCH_WARMUP", 2, 0, 1000);
+    const char *path = getenv("BENCH_JSON");
+    if (path && *path) {
+        s.json = fopen(path, "a");
+        if (!s.json) perror(path);
+    }
+    bench_perf_init(&s.perf);
+    if (!s.perf.open) printf("  (hardware counters unavailable: %s)\n", s.perf.why);
+    return s;
+}
+
+// Newton's method, so the harness needs no -lm
+static double bench_sqrt(double x) {
+    if (x <= 0.0) return 0.0;
+    double r = x > 1.0 ? x : 1.0;
+    for (int i = 0; i < 64; i++) r = 0.5 * (r + x / r);
+    return r;
+}
+
+static int bench_compare_doubles(const void *pa, const void *pb) {
+    double a = *(const double *)pa, b = *(const double *)pb;
+    return (a > b) - (a < b);
+}
+
+static double bench_median(double *v, int n) {
+    qsort(v, n, sizeof *v, bench_compare_doubles);
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2.0;
+}
+
+static void bench_json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', out);
+        if ((unsigned char)*s >= 0x20) fputc(*s, out);
+    }
+    fputc('"', out);
+}
+
+// Prints a counter per operation, or "n/a"
+static void bench_print_count(const char *label, double v) {
+    if (v < 0) printf("  %s n/a", label);
+    else printf("  %s %.3f", label, v);
+}
+
+static void bench_report(BenchSuite *suite, const BenchStats *st) {
+    printf("  %-28s %9.3f ns/op  %8.2f %s/op  (median of %d; p95 %.3f ns/op, sd %.1f%%)\n",
+           st->name, st->ns_per_op, st->ticks_per_op, BENCH_TICK_UNIT, st->reps, st->p95_ns_per_op,
+           st->mean_ns > 0 ? 100.0 * st->stddev_ns / st->mean_ns : 0.0);
+    if (suite->perf.open) {
+        printf("  %-28s", "");
+        bench_print_count("IPC", st->ipc);
+        bench_print_count("branch-misses/op", st->per_op[BENCH_BRANCH_MISSES]);
+        bench_print_count("L1d-misses/op", st->per_op[BENCH_L1D_MISSES]);
+        bench_print_count("instructions/op", st->per_op[BENCH_INSTRUCTIONS]);
+        printf("\n");
+    }
+    if (!suite->json) return;
+    FILE *out = suite->json;
+    fputs("{\"suite\":", out);
+    bench_json_string(out, suite->suite);
+    fputs(",\"variant\":", out);
+    bench_json_string(out, suite->variant ? suite->variant : "");
+    fputs(",\"case\":", out);
+    bench_json_string(out, st->name);
+    fputs(",\"compiler\":", out);
+    bench_json_string(out, BENCH_COMPILER);
+    fputs(",\"flags\":", out);
+    bench_json_string(out, BENCH_FLAGS);
+    fprintf(out, ",\"ops\":%llu,\"reps\":%d,\"warmup\":%d", (unsigned long long)st->ops, st->reps, suite->warmup);
+    fprintf(out, ",\"median_ns\":%.1f,\"p95_ns\":%.1f,\"mean_ns\":%.1f,\"stddev_ns\":%.1f,\"min_ns\":%.1f",
+            st->median_ns, st->p95_ns, st->mean_ns, st->stddev_ns, st->min_ns);
+    fprintf(out, ",\"ns_per_op\":%.4f,\"p95_ns_per_op\":%.4f,\"ticks_per_op\":%.4f,\"tick_unit\":\"%s\"",
+            st->ns_per_op, st->p95_ns_per_op, st->ticks_per_op, BENCH_TICK_UNIT);
+    for (int i = 0; i < BENCH_COUNTERS; i++) {
+        if (st->per_op[i] < 0) fprintf(out, ",\"%s_per_op\":null", bench_counter_names[i]);
+        else fprintf(out, ",\"%s_per_op\":%.4f", bench_counter_names[i], st->per_op[i]);
+    }
+    if (st->ipc < 0) fputs(",\"ipc\":null}\n", out);
+    else fprintf(out, ",\"ipc\":%.3f}\n", st->ipc);
+    fflush(out);
+}
+
+static void bench_finish(BenchRun *run) {
+    BenchSuite *suite = run->suite;
+    int n = suite->reps;
+    double ops = run->ops ? (double)run->ops : 1.0;
+    BenchStats st = { .ops = run->ops, .reps = n };
+    snprintf(st.name, sizeof st.name, "%s", run->name);
+
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) sum += run->ns[i];
+    st.mean_ns = sum / n;
+    double var = 0.0;
+    for (int i = 0; i < n; i++) var += (run->ns[i] - st.mean_ns) * (run->ns[i] - st.mean_ns);
+    st.stddev_ns = n > 1 ? bench_sqrt(var / (n - 1)) : 0.0;
+
+    st.median_ns = bench_median(run->ns, n);
+    st.min_ns = run->ns[0];
+    st.p95_ns = run->ns[(95 * n + 99) / 100 - 1];   // nearest rank
+    st.ns_per_op = st.median_ns / ops;
+    st.p95_ns_per_op = st.p95_ns / ops;
+    st.ticks_per_op = bench_median(run->ticks, n) / ops;
+    for (int c = 0; c < BENCH_COUNTERS; c++) {
+        st.per_op[c] = -1.0;
+        if (!suite->perf.open || run->counts[c][0] < 0) continue;
+        st.per_op[c] = bench_median(run->counts[c], n) / ops;
+    }
+    st.ipc = st.per_op[BENCH_CYCLES] > 0 && st.per_op[BENCH_INSTRUCTIONS] >= 0
+           ? st.per_op[BENCH_INSTRUCTIONS] / st.per_op[BENCH_CYCLES] : -1.0;
+
+    if (suite->ncases < BENCH_MAX_CASES) suite->cases[suite->ncases++] = st;
+    suite->total_median_ns += st.median_ns;
+    bench_report(suite, &st);
+}
+
+static inline BenchRun bench_begin(BenchSuite *suite, const char *name, uint64_t ops) {
+    return (BenchRun){ .suite = suite, .name = name, .ops = ops };
+}
+
+// Closes the previous repetition, then opens the next one or finishes
+static inline int bench_next(BenchRun *run) {
+    uint64_t end_ns = bench_now_ns(), end_ticks = bench_ticks();
+    BENCH_CLOBBER_MEMORY();
+    double counts[BENCH_COUNTERS] = { 0 };
+    if (run->iteration) bench_perf_stop(&run->suite->perf, counts);
+    int timed = run->iteration - 1 - run->suite->warmup;
+    if (timed >= 0) {
+        run->ns[timed] = (double)(end_ns - run->start_ns);
+        run->ticks[timed] = (double)(end_ticks - run->start_ticks);
+        if (run->suite->perf.open)
+            for (int c = 0; c < BENCH_COUNTERS; c++) run->counts[c][timed] = counts[c];
+    }
+    if (run->iteration == run->suite->warmup + run->suite->reps) {
+        bench_finish(run);
+        return 0;
+    }
+    run->iteration++;
+    bench_perf_start(&run->suite->perf);
+    run->start_ticks = bench_ticks();
+    run->start_ns = bench_now_ns();
+    BENCH_CLOBBER_MEMORY();
+    return 1;
+}
+
+// Runs the statement that follows (warmup + reps) times, timing each run
+#define BENCH(suite, name, ops) \
+    for (BenchRun __bench_run = bench_begin((suite), (name), (ops)); bench_next(&__bench_run); )
+
+static inline const BenchStats *bench_last(const BenchSuite *suite) {
+    return suite->ncases ? &suite->cases[suite->ncases - 1] : NULL;
+}
+
+// Prints the summary line; returns 0 so main can return it
+static inline int bench_suite_end(BenchSuite *suite) {
+    printf("Total: %.3f ms median over %d cases\n", suite->total_median_ns / 1e6, suite->ncases);
+    if (suite->json) fclose(suite->json);
+    suite->json = NULL;
+    bench_perf_close(&suite->perf);
+    return 0;
+}
+
+#endif // BENCH_H
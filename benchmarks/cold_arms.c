@@ -0,0 +1,122 @@
+/*
+ * when()/is() vs when_unlikely()/is_cold() for rare error arms
+ * The error arms format a log line; with the cold annotations their code
+ * moves to process_*.cold and the hot loop body shrinks
+ */
+
+#include "bench.h"
+#include "../match.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ELEMENTS (1 << 16)
+#define ROUNDS 20
+
+typedef struct {
+    int kind;      // 0 data, 1 ack, 2 malformed, 3 oversized
+    int len;
+    int seq;
+} Packet;
+
+static Packet packets[ELEMENTS];
+static char log_line[128];
+static int logged;
+
+__attribute__((noinline)) long process_plain(const Packet *p) {
+    long bytes = 0;
+    match_strict(p->kind, p->len) {
+        when(0, lt(1500)) { bytes = p->len; }
+        when(1, __) { bytes = 1; }
+        when(2, __) {
+            logged += snprintf(log_line, sizeof log_line, "malformed packet seq=%d len=%d", p->seq, p->len) > 0;
+            bytes = -1;
+        }
+        when(__, ge(1500)) {
+            logged += snprintf(log_line, sizeof log_line, "oversized packet seq=%d len=%d kind=%d",
+                               p->seq, p->len, p->kind) > 0;
+            bytes = -2;
+        }
+    }
+    return bytes;
+}
+
+__attribute__((noinline)) long process_cold(const Packet *p) {
+    long bytes = 0;
+    match_strict(p->kind, p->len) {
+        when_likely(0, lt(1500)) { bytes = p->len; }
+        when(1, __) { bytes = 1; }
+        when_unlikely(2, __) {
+            logged += snprintf(log_line, sizeof log_line, "malformed packet seq=%d len=%d", p->seq, p->len) > 0;
+            bytes = -1;
+        }
+        when_unlikely(__, ge(1500)) {
+            logged += snprintf(log_line, sizeof log_line, "oversized packet seq=%d len=%d kind=%d",
+                               p->seq, p->len, p->kind) > 0;
+            bytes = -2;
+        }
+    }
+    return bytes;
+}
+
+__attribute__((noinline)) int checksum_plain(int x) {
+    return let_strict(x) in(
+        is(lt(0)) ? snprintf(log_line, sizeof log_line, "negative checksum %d", x)
+        : x & 0xff
+    );
+}
+
+__attribute__((noinline)) int checksum_cold(int x) {
+    return let_strict(x) in(
+        is_cold(lt(0)) ? snprintf(log_line, sizeof log_line, "negative checksum %d", x)
+        : x & 0xff
+    );
+}
+
+static double time_process(BenchSuite *suite, const char *label, long (*fn)(const Packet *)) {
+    BENCH(suite, label, (uint64_t)ELEMENTS * ROUNDS) {
+        for (int r = 0; r < ROUNDS; r++)
+            for (int i = 0; i < ELEMENTS; i++) BENCH_DO_NOT_OPTIMIZE(fn(&packets[i]));
+    }
+    return bench_last(suite)->ticks_per_op;
+}
+
+static double time_checksum(BenchSuite *suite, const char *label, int (*fn)(int)) {
+    BENCH(suite, label, (uint64_t)ELEMENTS * ROUNDS) {
+        for (int r = 0; r < ROUNDS; r++)
+            for (int i = 0; i < ELEMENTS; i++) BENCH_DO_NOT_OPTIMIZE(fn(packets[i].seq));
+    }
+    return bench_last(suite)->ticks_per_op;
+}
+
+static void report(const char *name, double plain, double cold) {
+    printf("%-9s when/is: %6.2f %s/call | annotated: %6.2f %s/call\n",
+           name, plain, BENCH_TICK_UNIT, cold, BENCH_TICK_UNIT);
+}
+
+int main() {
+    printf("=== Cold Arms Benchmark ===\n");
+
+    BenchSuite suite = bench_suite("cold_arms", NULL);
+    srand(42);
+    for (int i = 0; i < ELEMENTS; i++) {
+        int r = rand() % 1000;
+        // 0.2% errors, the rest data and acks
+        packets[i] = (Packet){ r == 0 ? 2 : r < 700 ? 0 : 1, r == 1 ? 9000 : rand() % 1500, r == 3 ? -i : i };
+    }
+
+    for (int i = 0; i < ELEMENTS; i++) {
+        if (process_plain(&packets[i]) != process_cold(&packets[i]) ||
+            checksum_plain(packets[i].seq) != checksum_cold(packets[i].seq)) {
+            printf("Mismatch for packet %d\n", i);
+            return 1;
+        }
+    }
+
+    double plain = time_process(&suite, "process/when", process_plain);
+    report("process", plain, time_process(&suite, "process/annotated", process_cold));
+    plain = time_checksum(&suite, "checksum/is", checksum_plain);
+    report("checksum", plain, time_checksum(&suite, "checksum/annotated", checksum_cold));
+
+    printf("%d lines logged\n", logged);
+    return bench_suite_end(&suite);
+}
@@ -0,0 +1,93 @@
+/*
+ * tag_union vs tag_union_compact vs tag_union_packed over a large event array
+ * Reports bytes per element, total footprint and cycles per element for one
+ * streaming pass that matches every element. Pass an element count to run a
+ * smaller array (default 10M).
+ */
+
+#include "bench.h"
+#include "../match.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DEFAULT_ELEMENTS 10000000UL
+
+// Counter events: a count or a sampled ratio
+tag_union(Event, int, Count, float, Ratio)
+tag_union_compact(EventCompact, int, Count, float, Ratio)
+
+// Sensor readings: a double or a fault code
+tag_union(Reading, double, Celsius, int, Fault)
+tag_union_packed(ReadingPacked, double, Celsius, int, Fault)
+
+#define DEFINE_KERNELS(T) \
+    __attribute__((noinline)) static void fill_##T(T* out, size_t n) { \
+        for (size_t i = 0; i < n; i++) { \
+            out[i] = (i % 7 == 0) ? new_##T##_Ratio((float)(i & 15) * 0.25f) : new_##T##_Count((int)(i & 1023)); \
+        } \
+    } \
+    __attribute__((noinline)) static double sum_##T(const T* in, size_t n) { \
+        double total = 0; \
+        for (size_t i = 0; i < n; i++) { \
+            match(&in[i]) { \
+                when(variant(T##_Count)) { total += in[i].Count; } \
+                when(variant(T##_Ratio)) { total += in[i].Ratio; } \
+            } \
+        } \
+        return total; \
+    }
+
+#define DEFINE_READING_KERNELS(T) \
+    __attribute__((noinline)) static void fill_##T(T* out, size_t n) { \
+        for (size_t i = 0; i < n; i++) { \
+            out[i] = (i % 13 == 0) ? new_##T##_Fault((int)(i & 7)) : new_##T##_Celsius((double)(i & 63) * 0.5); \
+        } \
+    } \
+    __attribute__((noinline)) static double sum_##T(const T* in, size_t n) { \
+        double total = 0; \
+        for (size_t i = 0; i < n; i++) { \
+            match(&in[i]) { \
+                when(variant(T##_Celsius)) { total += in[i].Celsius; } \
+                when(variant(T##_Fault)) { total -= in[i].Fault; } \
+            } \
+        } \
+        return total; \
+    }
+
+DEFINE_KERNELS(Event)
+DEFINE_KERNELS(EventCompact)
+DEFINE_READING_KERNELS(Reading)
+DEFINE_READING_KERNELS(ReadingPacked)
+
+#define RUN(suite, T, n, label, result) do { \
+    T* data = malloc(sizeof(T) * (n)); \
+    if (!data) { printf("%-16s allocation of %zu MB failed\n", #T, sizeof(T) * (n) >> 20); break; } \
+    fill_##T(data, (n)); \
+    BENCH(suite, #T "/" label, (n)) { (result) = sum_##T(data, (n)); } \
+    printf("%-16s %-8s %2zu bytes/element | %6zu MB | %6.3f %s/element\n", \
+           #T, label, sizeof(T), sizeof(T) * (n) >> 20, bench_last(suite)->ticks_per_op, BENCH_TICK_UNIT); \
+    free(data); \
+} while (0)
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_ELEMENTS;
+    printf("=== Compact Layout Benchmark (%zu elements) ===\n", n);
+    BenchSuite suite = bench_suite("compact_layout", NULL);
+
+    double classic = 0, compact = 0;
+    RUN(&suite, Event, n, "classic", classic);
+    RUN(&suite, EventCompact, n, "compact", compact);
+    if (classic != compact) {
+        printf("Event: results differ\n");
+        return 1;
+    }
+
+    RUN(&suite, Reading, n, "classic", classic);
+    RUN(&suite, ReadingPacked, n, "packed", compact);
+    if (classic != compact) {
+        printf("Reading: results differ\n");
+        return 1;
+    }
+
+    return bench_suite_end(&suite);
+}
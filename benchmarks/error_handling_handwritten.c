@@ -4,8 +4,8 @@
  * Uses the same Result types as the pattern matching system, but with manual operations
  */
 
+#include "bench.h"
 #include <stdio.h>
-#include <time.h>
 #include <stdlib.h>
 #include <string.h>
 #include "../match.h"
@@ -34,37 +34,32 @@ int main() {
     const int ITERATIONS = 10000000;
     
     printf("=== Hand-written Error Handling Benchmark ===\n");
-    
-    clock_t start = clock();
+    BenchSuite suite = bench_suite("error_handling", "handwritten");
     
     // Benchmark 1: Division with error handling using manual Result operations
-    volatile double div_result = 0.0;
-    for (int i = 0; i < ITERATIONS; i++) {
-        Result_double result = divide_handwritten(100.0, (double)(i % 10));
-        // Manual check instead of pattern matching
-        if (result.tag == Result_Ok) {
-            div_result += result.Ok;
+    BENCH(&suite, "divide", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) {
+            Result_double result = divide_handwritten(100.0, (double)(i % 10));
+            // Manual check instead of pattern matching
+            if (result.tag == Result_Ok) {
+                BENCH_DO_NOT_OPTIMIZE(result.Ok);
+            }
+            // Ignore errors manually instead of using when(Err)
         }
-        // Ignore errors manually instead of using when(Err)
     }
     
     // Benchmark 2: Parsing with error handling using manual Result operations
-    volatile int parse_result = 0;
     const char* test_strings[] = {"42", "", "invalid", "42"};
-    for (int i = 0; i < ITERATIONS; i++) {
-        Result_int result = parse_int_handwritten(test_strings[i % 4]);
-        // Manual check instead of pattern matching
-        if (result.tag == Result_Ok) {
-            parse_result += result.Ok;
+    BENCH(&suite, "parse", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) {
+            Result_int result = parse_int_handwritten(test_strings[i % 4]);
+            // Manual check instead of pattern matching
+            if (result.tag == Result_Ok) {
+                BENCH_DO_NOT_OPTIMIZE(result.Ok);
+            }
+            // Ignore errors manually instead of using when(Err)
         }
-        // Ignore errors manually instead of using when(Err)
     }
     
-    clock_t end = clock();
-    double time_taken = ((double)(end - start)) / CLOCKS_PER_SEC;
-    
-    printf("Completed %d iterations in %f seconds\n", ITERATIONS * 2, time_taken);
-    printf("Results: div=%f, parse=%d\n", div_result, parse_result);
-    
-    return 0;
+    return bench_suite_end(&suite);
 }
@@ -0,0 +1,81 @@
+/*
+ * Float patterns: hand-written if/else vs let() vs match_batch_double
+ * Classifies the same array of temperature readings (with some NaNs) three
+ * ways and reports cycles per element
+ */
+
+#include "bench.h"
+#include "../match.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define ELEMENTS (1 << 16)
+#define ROUNDS 20
+
+static double temps[ELEMENTS];
+static uint8_t ref_out[ELEMENTS];
+static uint8_t out[ELEMENTS];
+
+__attribute__((noinline)) void classify_handwritten(const double* in, size_t n, uint8_t* o) {
+    for (size_t i = 0; i < n; i++) {
+        double t = in[i];
+        if (isnan(t)) o[i] = 0;
+        else if (t < 0.0) o[i] = 1;
+        else if (t < 25.5) o[i] = 2;
+        else if (t <= 40.0) o[i] = 3;
+        else o[i] = 4;
+    }
+}
+
+__attribute__((noinline)) void classify_let(const double* in, size_t n, uint8_t* o) {
+    for (size_t i = 0; i < n; i++) {
+        o[i] = let(in[i]) in(
+            is(fnan) ? 0
+            : is(flt(0.0)) ? 1
+            : is(flt(25.5)) ? 2
+            : is(fle(40.0)) ? 3
+            : 4
+        );
+    }
+}
+
+__attribute__((noinline)) void classify_batch(const double* in, size_t n, uint8_t* o) {
+    match_batch_double(in, n, o, fnan, flt(0.0), flt(25.5), fle(40.0), __);
+}
+
+static void run(BenchSuite* suite, const char* name, void (*kernel)(const double*, size_t, uint8_t*)) {
+    BENCH(suite, name, (uint64_t)ELEMENTS * ROUNDS) {
+        for (int r = 0; r < ROUNDS; r++) kernel(temps, ELEMENTS, out);
+    }
+    
+    for (int i = 0; i < ELEMENTS; i++) {
+        if (out[i] != ref_out[i]) {
+            printf("%s: mismatch at %d\n", name, i);
+            exit(1);
+        }
+    }
+}
+
+int main() {
+    printf("=== Float Classification Benchmark ===\n");
+    BenchSuite suite = bench_suite("float_classify", NULL);
+#if MATCH_BATCH_X86
+    printf("Kernel: %s\n", __builtin_cpu_supports("avx2") ? "AVX2" : "scalar");
+#else
+    printf("Kernel: scalar\n");
+#endif
+    
+    // Random readings in [-20, 60) with 1% NaN, so the arm chain can't be predicted
+    srand(42);
+    for (int i = 0; i < ELEMENTS; i++) {
+        temps[i] = rand() % 100 == 0 ? NAN : -20.0 + (rand() % 8000) / 100.0;
+    }
+    classify_handwritten(temps, ELEMENTS, ref_out);
+    
+    run(&suite, "handwritten", classify_handwritten);
+    run(&suite, "let", classify_let);
+    run(&suite, "match_batch_double", classify_batch);
+    
+    return bench_suite_end(&suite);
+}
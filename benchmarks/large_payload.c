@@ -0,0 +1,101 @@
+/*
+ * By-value vs in-place construction and access of large Result payloads
+ * For payloads of 8 to 1024 bytes, produces a Result per iteration and reads
+ * it back: once with ok_TYPE() + unwrap_or() (copies the payload into the
+ * Result and out again), once with ok_TYPE_into() + unwrap_ref() (builds it
+ * in the caller's Result and reads it through a pointer). Pass an iteration
+ * count to run fewer (default 1M).
+ */
+
+#include "bench.h"
+#include "../match.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DEFAULT_ITERATIONS 1000000UL
+
+// noipa keeps GCC from proving the producers pure and folding the loops away
+
+// Every 64th request is rejected, so both paths keep their Err branch
+#define DEFINE_PAYLOAD(N) \
+    typedef struct { uint64_t words[(N) / 8]; } Payload##N; \
+    CreateResult(Payload##N) \
+    \
+    __attribute__((noipa)) static uint64_t checksum_##N(const Payload##N* p) { \
+        return p->words[0] ^ p->words[(N) / 8 - 1]; \
+    } \
+    \
+    __attribute__((noipa)) static Result_Payload##N make_##N(uint64_t seed) { \
+        if (seed % 64 == 63) return err_Payload##N("rejected"); \
+        Payload##N p; \
+        for (size_t k = 0; k < (N) / 8; k++) p.words[k] = seed + k; \
+        return ok_Payload##N(p); \
+    } \
+    \
+    __attribute__((noipa)) static void make_##N##_into(Result_Payload##N* out, uint64_t seed) { \
+        if (seed % 64 == 63) { *out = err_Payload##N("rejected"); return; } \
+        Payload##N* p = ok_Payload##N##_into(out); \
+        for (size_t k = 0; k < (N) / 8; k++) p->words[k] = seed + k; \
+    } \
+    \
+    __attribute__((noipa)) static uint64_t by_value_##N(size_t n) { \
+        const Payload##N empty = {{0}}; \
+        uint64_t sum = 0; \
+        for (size_t i = 0; i < n; i++) { \
+            Result_Payload##N r = make_##N(i); \
+            Payload##N v = unwrap_or(&r, empty); \
+            sum += checksum_##N(&v); \
+        } \
+        return sum; \
+    } \
+    \
+    __attribute__((noipa)) static uint64_t in_place_##N(size_t n) { \
+        const Payload##N empty = {{0}}; \
+        uint64_t sum = 0; \
+        for (size_t i = 0; i < n; i++) { \
+            Result_Payload##N r; \
+            make_##N##_into(&r, i); \
+            sum += checksum_##N(unwrap_ref(&r, &empty)); \
+        } \
+        return sum; \
+    }
+
+DEFINE_PAYLOAD(8)
+DEFINE_PAYLOAD(16)
+DEFINE_PAYLOAD(32)
+DEFINE_PAYLOAD(64)
+DEFINE_PAYLOAD(128)
+DEFINE_PAYLOAD(256)
+DEFINE_PAYLOAD(512)
+DEFINE_PAYLOAD(1024)
+
+#define RUN(suite, N, n) do { \
+    uint64_t copied = 0, placed = 0; \
+    BENCH(suite, #N "/by_value", (n)) { copied = by_value_##N(n); } \
+    double value_cost = bench_last(suite)->ticks_per_op; \
+    BENCH(suite, #N "/in_place", (n)) { placed = in_place_##N(n); } \
+    double place_cost = bench_last(suite)->ticks_per_op; \
+    printf("%5d bytes | by value: %8.2f %s/op | in place: %8.2f %s/op | %5.2fx\n", \
+           N, value_cost, BENCH_TICK_UNIT, place_cost, BENCH_TICK_UNIT, value_cost / place_cost); \
+    if (copied != placed) { \
+        printf("%d bytes: results differ\n", N); \
+        return 1; \
+    } \
+} while (0)
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_ITERATIONS;
+    printf("=== Large Payload Benchmark (%zu iterations) ===\n", n);
+    BenchSuite suite = bench_suite("large_payload", NULL);
+
+    RUN(&suite, 8, n);
+    RUN(&suite, 16, n);
+    RUN(&suite, 32, n);
+    RUN(&suite, 64, n);
+    RUN(&suite, 128, n);
+    RUN(&suite, 256, n);
+    RUN(&suite, 512, n);
+    RUN(&suite, 1024, n);
+
+    return bench_suite_end(&suite);
+}
@@ -3,8 +3,8 @@
  * This serves as the baseline for let() expression comparison
  */
 
+#include "bench.h"
 #include <stdio.h>
-#include <time.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -45,39 +45,28 @@ int main() {
     const int ITERATIONS = 10000000;
     
     printf("=== Hand-written Conditional Expressions Benchmark ===\n");
-    
-    clock_t start = clock();
+    BenchSuite suite = bench_suite("let_expressions", "handwritten");
     
     // Benchmark 1: Grade calculation
-    volatile char grade_sum = 0;
-    for (int i = 0; i < ITERATIONS; i++) {
-        grade_sum += grade_from_score_handwritten(i % 100);
+    BENCH(&suite, "grade", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(grade_from_score_handwritten(i % 100));
     }
     
     // Benchmark 2: Coordinate categorization
-    volatile int category_sum = 0;
-    for (int i = 0; i < ITERATIONS; i++) {
-        category_sum += categorize_value_handwritten(i % 21 - 10, i % 31 - 15);
+    BENCH(&suite, "categorize", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(categorize_value_handwritten(i % 21 - 10, i % 31 - 15));
     }
     
     // Benchmark 3: Mathematical computation
-    volatile double math_sum = 0.0;
-    for (int i = 0; i < ITERATIONS; i++) {
-        math_sum += compute_result_handwritten((double)(i % 200), (double)((i + 1) % 10 + 1));
+    BENCH(&suite, "compute", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++)
+            BENCH_DO_NOT_OPTIMIZE(compute_result_handwritten((double)(i % 200), (double)((i + 1) % 10 + 1)));
     }
     
     // Benchmark 4: Range processing
-    volatile int range_sum = 0;
-    for (int i = 0; i < ITERATIONS; i++) {
-        range_sum += process_range_handwritten(i % 100);
+    BENCH(&suite, "range", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(process_range_handwritten(i % 100));
     }
     
-    clock_t end = clock();
-    double time_taken = ((double)(end - start)) / CLOCKS_PER_SEC;
-    
-    printf("Completed %d iterations in %f seconds\n", ITERATIONS * 4, time_taken);
-    printf("Results: grade=%d, category=%d, math=%f, range=%d\n", 
-           (int)grade_sum, category_sum, math_sum, range_sum);
-    
-    return 0;
+    return bench_suite_end(&suite);
 }
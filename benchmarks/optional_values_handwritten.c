@@ -4,8 +4,8 @@
  * Uses the same Option types as the pattern matching system, but with manual operations
  */
 
+#include "bench.h"
 #include <stdio.h>
-#include <time.h>
 #include <stdlib.h>
 #include <string.h>
 #include "../match.h"
@@ -36,40 +36,35 @@ int main() {
     const int ITERATIONS = 10000000;
     
     printf("=== Hand-written Optional Values Benchmark ===\n");
-    
-    clock_t start = clock();
+    BenchSuite suite = bench_suite("optional_values", "handwritten");
     
     // Test data
     int test_array[] = {1, 3, 5, 7, 9, 11, 13, 15, 17, 19};
     const char* config_keys[] = {"debug", "port", "invalid", "debug"};
     
     // Benchmark 1: Array search with Option types using manual operations
-    volatile int found_count = 0;
-    for (int i = 0; i < ITERATIONS; i++) {
-        Option_int result = find_in_array_handwritten(test_array, 10, i % 20);
-        // Manual check instead of pattern matching
-        if (result.tag == Option_Some) {
-            found_count += result.Some;
+    BENCH(&suite, "find", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) {
+            Option_int result = find_in_array_handwritten(test_array, 10, i % 20);
+            // Manual check instead of pattern matching
+            if (result.tag == Option_Some) {
+                BENCH_DO_NOT_OPTIMIZE(result.Some);
+            }
+            // Ignore None manually instead of using when(None)
         }
-        // Ignore None manually instead of using when(None)
     }
     
     // Benchmark 2: Config lookup with Option types using manual operations
-    volatile int config_count = 0;
-    for (int i = 0; i < ITERATIONS; i++) {
-        Option_char_ptr result = get_config_handwritten(config_keys[i % 4]);
-        // Manual check instead of pattern matching
-        if (result.tag == Option_Some) {
-            config_count += strlen(result.Some);
+    BENCH(&suite, "config", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) {
+            Option_char_ptr result = get_config_handwritten(config_keys[i % 4]);
+            // Manual check instead of pattern matching (NULL is None)
+            if (result.Some != NULL) {
+                BENCH_DO_NOT_OPTIMIZE(strlen(result.Some));
+            }
+            // Ignore None manually instead of using when(None)
         }
-        // Ignore None manually instead of using when(None)
     }
     
-    clock_t end = clock();
-    double time_taken = ((double)(end - start)) / CLOCKS_PER_SEC;
-    
-    printf("Completed %d iterations in %f seconds\n", ITERATIONS * 2, time_taken);
-    printf("Results: found=%d, config=%d\n", found_count, config_count);
-    
-    return 0;
+    return bench_suite_end(&suite);
 }
@@ -0,0 +1,46 @@
+/*
+ * Hand-written C implementation of 64-bit bucket classification
+ * This serves as the baseline for comparison with match.h range patterns
+ */
+
+#include "bench.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Hand-written latency bucketing (microseconds)
+int latency_bucket_handwritten(int64_t us) {
+    if (us >= 0 && us <= 999) return 0;
+    else if (us >= 1000 && us <= 99999) return 1;
+    else if (us >= 100000 && us <= 999999) return 2;
+    else if (us >= 1000000 && us <= 59999999) return 3;
+    else return 4;
+}
+
+// Hand-written byte size classes
+int size_class_handwritten(uint64_t bytes) {
+    if (bytes < 4096) return 0;
+    else if (bytes > 4095 && bytes < (UINT64_C(1) << 20)) return 1;
+    else if (bytes >= (UINT64_C(1) << 20) && bytes <= (UINT64_C(1) << 32)) return 2;
+    else return 3;
+}
+
+int main() {
+    const int ITERATIONS = 10000000;
+    
+    printf("=== Hand-written C Benchmark ===\n");
+    BenchSuite suite = bench_suite("range_buckets", "handwritten");
+    
+    // Benchmark 1: Latency buckets
+    BENCH(&suite, "latency", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++)
+            BENCH_DO_NOT_OPTIMIZE(latency_bucket_handwritten((int64_t)(i % 1000) * 97 * (i % 1013)));
+    }
+    
+    // Benchmark 2: Size classes
+    BENCH(&suite, "size", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(size_class_handwritten((uint64_t)i << (i % 24)));
+    }
+    
+    return bench_suite_end(&suite);
+}
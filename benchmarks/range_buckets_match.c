@@ -0,0 +1,51 @@
+/*
+ * Pattern matching implementation using match.h
+ * Range bounds past 16 bits should compile to the same compares as the hand-written version
+ */
+
+#include "bench.h"
+#include "../match.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Pattern matching latency bucketing (microseconds)
+int latency_bucket_match(int64_t us) {
+    return let(us) in(
+        is(between(0, 999)) ? 0
+        : is(between(1000, 99999)) ? 1
+        : is(between(100000, 999999)) ? 2
+        : is(between(1000000, 59999999)) ? 3
+        : 4
+    );
+}
+
+// Pattern matching byte size classes
+int size_class_match(uint64_t bytes) {
+    return let(bytes) in(
+        is(ubetween(0, 4095)) ? 0
+        : is(range(4095ULL, UINT64_C(1) << 20)) ? 1
+        : is(between(UINT64_C(1) << 20, UINT64_C(1) << 32)) ? 2
+        : 3
+    );
+}
+
+int main() {
+    const int ITERATIONS = 10000000;
+    
+    printf("=== Pattern Matching Benchmark ===\n");
+    BenchSuite suite = bench_suite("range_buckets", "match");
+    
+    // Benchmark 1: Latency buckets
+    BENCH(&suite, "latency", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++)
+            BENCH_DO_NOT_OPTIMIZE(latency_bucket_match((int64_t)(i % 1000) * 97 * (i % 1013)));
+    }
+    
+    // Benchmark 2: Size classes
+    BENCH(&suite, "size", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(size_class_match((uint64_t)i << (i % 24)));
+    }
+    
+    return bench_suite_end(&suite);
+}
@@ -0,0 +1,98 @@
+/*
+ * Branchless match_ranges() vs the let() ladder from calculate_grade_match
+ * Runs both on sorted (predictable) and random (unpredictable) scores
+ */
+
+#include "bench.h"
+#include "../match.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ELEMENTS (1 << 16)
+#define ROUNDS 20
+
+static int scores[ELEMENTS];
+
+__attribute__((noinline)) char calculate_grade_ladder(int score) {
+    return let(score) in(
+        is(ge(90)) ? 'A'
+        : is(ge(80)) ? 'B'
+        : is(ge(70)) ? 'C'
+        : is(ge(60)) ? 'D'
+        : 'F'
+    );
+}
+
+__attribute__((noinline)) char calculate_grade_ranges(int score) {
+    return "ABCDF"[match_ranges(score, ge(90), ge(80), ge(70), ge(60))];
+}
+
+static const int64_t latency_thresholds[] = { 10, 20, 30, 40, 50, 60, 70, 80, 90 };
+
+__attribute__((noinline)) int latency_bucket_ladder(int64_t us) {
+    return let(us) in(
+        is(lt(10)) ? 0 : is(lt(20)) ? 1 : is(lt(30)) ? 2 : is(lt(40)) ? 3 : is(lt(50)) ? 4
+        : is(lt(60)) ? 5 : is(lt(70)) ? 6 : is(lt(80)) ? 7 : is(lt(90)) ? 8 : 9
+    );
+}
+
+__attribute__((noinline)) int latency_bucket_table(int64_t us) {
+    return (int)match_bucket(us, latency_thresholds, 9);
+}
+
+static double time_char(BenchSuite* suite, const char* label, char (*fn)(int)) {
+    BENCH(suite, label, (uint64_t)ELEMENTS * ROUNDS) {
+        for (int r = 0; r < ROUNDS; r++)
+            for (int i = 0; i < ELEMENTS; i++) BENCH_DO_NOT_OPTIMIZE(fn(scores[i]));
+    }
+    return bench_last(suite)->ticks_per_op;
+}
+
+static double time_int(BenchSuite* suite, const char* label, int (*fn)(int64_t)) {
+    BENCH(suite, label, (uint64_t)ELEMENTS * ROUNDS) {
+        for (int r = 0; r < ROUNDS; r++)
+            for (int i = 0; i < ELEMENTS; i++) BENCH_DO_NOT_OPTIMIZE(fn(scores[i]));
+    }
+    return bench_last(suite)->ticks_per_op;
+}
+
+static void report(const char* name, const char* input, double ladder, double branchless) {
+    printf("%-8s %-7s ladder: %6.2f %s/call | branchless: %6.2f %s/call\n",
+           name, input, ladder, BENCH_TICK_UNIT, branchless, BENCH_TICK_UNIT);
+}
+
+static int compare_ints(const void* a, const void* b) {
+    return *(const int*)a - *(const int*)b;
+}
+
+int main() {
+    printf("=== Range Ladder Benchmark ===\n");
+    
+    BenchSuite suite = bench_suite("range_ladder", NULL);
+    double ladder;
+    srand(42);
+    for (int i = 0; i < ELEMENTS; i++) scores[i] = rand() % 100;
+    
+    for (int i = 0; i < ELEMENTS; i++) {
+        if (calculate_grade_ladder(scores[i]) != calculate_grade_ranges(scores[i]) ||
+            latency_bucket_ladder(scores[i]) != latency_bucket_table(scores[i])) {
+            printf("Mismatch for %d\n", scores[i]);
+            return 1;
+        }
+    }
+    
+    // Random order: the ladder's branches are unpredictable
+    ladder = time_char(&suite, "grade/random/ladder", calculate_grade_ladder);
+    report("grade", "random", ladder, time_char(&suite, "grade/random/branchless", calculate_grade_ranges));
+    ladder = time_int(&suite, "bucket/random/ladder", latency_bucket_ladder);
+    report("bucket", "random", ladder, time_int(&suite, "bucket/random/branchless", latency_bucket_table));
+    
+    // Sorted order: the ladder's branches are almost perfectly predicted
+    qsort(scores, ELEMENTS, sizeof(scores[0]), compare_ints);
+    ladder = time_char(&suite, "grade/sorted/ladder", calculate_grade_ladder);
+    report("grade", "sorted", ladder, time_char(&suite, "grade/sorted/branchless", calculate_grade_ranges));
+    ladder = time_int(&suite, "bucket/sorted/ladder", latency_bucket_ladder);
+    report("bucket", "sorted", ladder, time_int(&suite, "bucket/sorted/branchless", latency_bucket_table));
+    
+    return bench_suite_end(&suite);
+}
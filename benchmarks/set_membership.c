@@ -0,0 +1,94 @@
+/*
+ * any_of() vs a chain of is() arms joined with ||
+ * Classifies the same random inputs both ways and reports cycles per element
+ */
+
+#include "bench.h"
+#include "../match.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define ELEMENTS (1 << 16)
+#define ROUNDS 20
+
+static int32_t tokens[ELEMENTS];
+static int32_t statuses[ELEMENTS];
+
+// Token kinds that start an expression (values in 0..63: bitmask)
+__attribute__((noinline)) int count_starts_chain(const int32_t* in, size_t n) {
+    int count = 0;
+    for (size_t i = 0; i < n; i++) {
+        count += let(in[i]) in(
+            is(1) || is(4) || is(9) || is(12) || is(17) || is(23) || is(30) || is(41) ? 1 : 0
+        );
+    }
+    return count;
+}
+
+__attribute__((noinline)) int count_starts_any_of(const int32_t* in, size_t n) {
+    int count = 0;
+    for (size_t i = 0; i < n; i++) {
+        count += let(in[i]) in(is(any_of(1, 4, 9, 12, 17, 23, 30, 41)) ? 1 : 0);
+    }
+    return count;
+}
+
+// Retryable HTTP status codes (wide values: SIMD compare)
+__attribute__((noinline)) int count_retry_chain(const int32_t* in, size_t n) {
+    int count = 0;
+    for (size_t i = 0; i < n; i++) {
+        count += let_strict(in[i]) in(
+            is(408) || is(425) || is(429) || is(500) || is(502) || is(503) || is(504) ? 1 : 0
+        );
+    }
+    return count;
+}
+
+__attribute__((noinline)) int count_retry_any_of(const int32_t* in, size_t n) {
+    int count = 0;
+    for (size_t i = 0; i < n; i++) {
+        count += let_strict(in[i]) in(is(any_of(408, 425, 429, 500, 502, 503, 504)) ? 1 : 0);
+    }
+    return count;
+}
+
+static void run(BenchSuite* suite, const char* name, const int32_t* in,
+                int (*chain)(const int32_t*, size_t), int (*any)(const int32_t*, size_t)) {
+    if (chain(in, ELEMENTS) != any(in, ELEMENTS)) {
+        printf("%s: results differ\n", name);
+        exit(1);
+    }
+    
+    char label[64];
+    snprintf(label, sizeof label, "%s/chain", name);
+    BENCH(suite, label, (uint64_t)ELEMENTS * ROUNDS) {
+        for (int r = 0; r < ROUNDS; r++) BENCH_DO_NOT_OPTIMIZE(chain(in, ELEMENTS));
+    }
+    double chain_ticks = bench_last(suite)->ticks_per_op;
+    
+    snprintf(label, sizeof label, "%s/any_of", name);
+    BENCH(suite, label, (uint64_t)ELEMENTS * ROUNDS) {
+        for (int r = 0; r < ROUNDS; r++) BENCH_DO_NOT_OPTIMIZE(any(in, ELEMENTS));
+    }
+    double any_ticks = bench_last(suite)->ticks_per_op;
+    
+    printf("%-8s || chain: %6.3f %s/element | any_of: %6.3f %s/element | speedup %5.2fx\n",
+           name, chain_ticks, BENCH_TICK_UNIT, any_ticks, BENCH_TICK_UNIT, chain_ticks / any_ticks);
+}
+
+int main() {
+    printf("=== Set Membership Benchmark ===\n");
+    BenchSuite suite = bench_suite("set_membership", NULL);
+    
+    srand(42);
+    static const int32_t codes[] = { 200, 201, 204, 301, 304, 400, 404, 408, 425, 429, 500, 502, 503, 504 };
+    for (int i = 0; i < ELEMENTS; i++) {
+        tokens[i] = rand() % 48;
+        statuses[i] = codes[rand() % (int)(sizeof codes / sizeof *codes)];
+    }
+    
+    run(&suite, "mask", tokens, count_starts_chain, count_starts_any_of);
+    run(&suite, "simd", statuses, count_retry_chain, count_retry_any_of);
+    
+    return bench_suite_end(&suite);
+}
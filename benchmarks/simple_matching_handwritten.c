@@ -3,8 +3,8 @@
  * This serves as the baseline for comparison with match.h
  */
 
+#include "bench.h"
 #include <stdio.h>
-#include <time.h>
 #include <stdlib.h>
 
 // Hand-written grade calculation
@@ -36,33 +36,23 @@ int main() {
     const int ITERATIONS = 10000000;
     
     printf("=== Hand-written C Benchmark ===\n");
-    
-    clock_t start = clock();
+    BenchSuite suite = bench_suite("simple_matching", "handwritten");
     
     // Benchmark 1: Grade calculation
-    volatile char grade_result = 0;
-    for (int i = 0; i < ITERATIONS; i++) {
-        grade_result += calculate_grade_handwritten(i % 100);
+    BENCH(&suite, "grade", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(calculate_grade_handwritten(i % 100));
     }
     
     // Benchmark 2: Range checking
-    volatile int range_result = 0;
-    for (int i = 0; i < ITERATIONS; i++) {
-        range_result += check_range_handwritten(i % 100);
+    BENCH(&suite, "range", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(check_range_handwritten(i % 100));
     }
     
     // Benchmark 3: Coordinate processing
-    volatile int coord_result = 0;
-    for (int i = 0; i < ITERATIONS; i++) {
-        coord_result += process_coordinates_handwritten(i % 21 - 10, i % 31 - 15);
+    BENCH(&suite, "coordinates", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++)
+            BENCH_DO_NOT_OPTIMIZE(process_coordinates_handwritten(i % 21 - 10, i % 31 - 15));
     }
     
-    clock_t end = clock();
-    double time_taken = ((double)(end - start)) / CLOCKS_PER_SEC;
-    
-    printf("Completed %d iterations in %f seconds\n", ITERATIONS * 3, time_taken);
-    printf("Results: grade=%d, range=%d, coord=%d\n", 
-           (int)grade_result, range_result, coord_result);
-    
-    return 0;
+    return bench_suite_end(&suite);
 }
@@ -0,0 +1,162 @@
+/*
+ * Auto vs strict dispatch on the simple_matching kernels
+ * Measures cycles per call and per arm tested for let() and let_strict()
+ */
+
+#include "bench.h"
+#include "../match.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Auto mode (default): literal arms may speculatively read a tag
+__attribute__((noinline)) char calculate_grade_auto(int score) {
+    return let(score) in(
+        is(ge(90)) ? 'A'
+        : is(ge(80)) ? 'B'
+        : is(ge(70)) ? 'C'
+        : is(ge(60)) ? 'D'
+        : 'F'
+    );
+}
+
+__attribute__((noinline)) int check_range_auto(int value) {
+    return let(value) in(
+        is(gt(50)) ? 100
+        : is(between(20, 30)) ? 50
+        : is(gt(10)) ? 25
+        : 0
+    );
+}
+
+__attribute__((noinline)) int process_coordinates_auto(int x, int y) {
+    return let(x, y) in(
+        is(0, 0) ? 0
+        : is(gt(0), gt(0)) ? 1
+        : is(lt(0), lt(0)) ? 2
+        : 3
+    );
+}
+
+// Strict mode: integer subjects are never dereferenced
+__attribute__((noinline)) char calculate_grade_strict(int score) {
+    return let_strict(score) in(
+        is(ge(90)) ? 'A'
+        : is(ge(80)) ? 'B'
+        : is(ge(70)) ? 'C'
+        : is(ge(60)) ? 'D'
+        : 'F'
+    );
+}
+
+__attribute__((noinline)) int check_range_strict(int value) {
+    return let_strict(value) in(
+        is(gt(50)) ? 100
+        : is(between(20, 30)) ? 50
+        : is(gt(10)) ? 25
+        : 0
+    );
+}
+
+__attribute__((noinline)) int process_coordinates_strict(int x, int y) {
+    return let_strict(x, y) in(
+        is(0, 0) ? 0
+        : is(gt(0), gt(0)) ? 1
+        : is(lt(0), lt(0)) ? 2
+        : 3
+    );
+}
+
+// Statement form of the coordinate kernel: here the subject itself is passed
+// to the auto-variant check, so auto mode pays a range test and, for values
+// above 0x1000, a speculative load per literal arm
+__attribute__((noinline)) int process_coordinates_stmt_auto(int x, int y) {
+    int r = 3;
+    match(x, y) {
+        when(0, 0) { r = 0; }
+        when(gt(0), gt(0)) { r = 1; }
+        when(lt(0), lt(0)) { r = 2; }
+    }
+    return r;
+}
+
+__attribute__((noinline)) int process_coordinates_stmt_strict(int x, int y) {
+    int r = 3;
+    match_strict(x, y) {
+        when(0, 0) { r = 0; }
+        when(gt(0), gt(0)) { r = 1; }
+        when(lt(0), lt(0)) { r = 2; }
+    }
+    return r;
+}
+
+// Number of arms tested before the first match (the default counts as tested)
+static int grade_arms(int score) { return score >= 90 ? 1 : score >= 80 ? 2 : score >= 70 ? 3 : 4; }
+static int range_arms(int v) { return v > 50 ? 1 : (v >= 20 && v <= 30) ? 2 : 3; }
+static int coord_arms(int x, int y) {
+    return (x == 0 && y == 0) ? 1 : (x > 0 && y > 0) ? 2 : 3;
+}
+
+// Takes the median per-call ticks of the two latest cases: auto, then strict
+static void report(BenchSuite* suite, const char* name, long calls, long arms) {
+    double auto_ticks = suite->cases[suite->ncases - 2].ticks_per_op;
+    double strict_ticks = suite->cases[suite->ncases - 1].ticks_per_op;
+    double arms_per_call = (double)arms / calls;
+    printf("%-20s auto: %6.2f %s/call %5.2f %s/arm | strict: %6.2f %s/call %5.2f %s/arm | saved %5.2f %s/arm\n",
+           name,
+           auto_ticks, BENCH_TICK_UNIT, auto_ticks / arms_per_call, BENCH_TICK_UNIT,
+           strict_ticks, BENCH_TICK_UNIT, strict_ticks / arms_per_call, BENCH_TICK_UNIT,
+           (auto_ticks - strict_ticks) / arms_per_call, BENCH_TICK_UNIT);
+}
+
+int main() {
+    const int ITERATIONS = 1000000;
+    
+    printf("=== Strict Dispatch Benchmark ===\n");
+    
+    long grade_arm_count = 0, range_arm_count = 0, coord_arm_count = 0;
+    for (int i = 0; i < ITERATIONS; i++) {
+        grade_arm_count += grade_arms(i % 100);
+        range_arm_count += range_arms(i % 100);
+        coord_arm_count += coord_arms(i % 21 - 10, i % 31 - 15);
+    }
+    
+    BenchSuite suite = bench_suite("strict_dispatch", NULL);
+    
+    // Benchmark 1: Grade calculation
+    BENCH(&suite, "grade/auto", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(calculate_grade_auto(i % 100));
+    }
+    BENCH(&suite, "grade/strict", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(calculate_grade_strict(i % 100));
+    }
+    report(&suite, "grade", ITERATIONS, grade_arm_count);
+    
+    // Benchmark 2: Range checking
+    BENCH(&suite, "range/auto", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(check_range_auto(i % 100));
+    }
+    BENCH(&suite, "range/strict", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(check_range_strict(i % 100));
+    }
+    report(&suite, "range", ITERATIONS, range_arm_count);
+    
+    // Benchmark 3: Coordinate processing (literal arms)
+    BENCH(&suite, "coordinates/auto", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(process_coordinates_auto(i % 21 - 10, i % 31 - 15));
+    }
+    BENCH(&suite, "coordinates/strict", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(process_coordinates_strict(i % 21 - 10, i % 31 - 15));
+    }
+    report(&suite, "coordinates", ITERATIONS, coord_arm_count);
+    
+    // Benchmark 4: Coordinate processing, statement form
+    BENCH(&suite, "coordinates_match/auto", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(process_coordinates_stmt_auto(i % 21 - 10, i % 31 - 15));
+    }
+    BENCH(&suite, "coordinates_match/strict", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) BENCH_DO_NOT_OPTIMIZE(process_coordinates_stmt_strict(i % 21 - 10, i % 31 - 15));
+    }
+    report(&suite, "coordinates (match)", ITERATIONS, coord_arm_count);
+    
+    return bench_suite_end(&suite);
+}
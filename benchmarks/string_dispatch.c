@@ -0,0 +1,138 @@
+/*
+ * str() patterns vs a strcmp chain on HTTP method and header-name routing
+ * Looks up the same random token stream both ways and reports cycles per lookup
+ */
+
+#include "bench.h"
+#include "../match.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define TOKENS 4096
+#define ROUNDS 200
+
+static const char* headers[] = {
+    "host", "user-agent", "accept", "accept-encoding", "accept-language",
+    "connection", "content-type", "content-length", "cookie", "authorization",
+    "cache-control", "if-none-match", "if-modified-since", "referer", "x-request-id",
+    "x-forwarded-for", "upgrade-insecure-requests", "origin", "x-unknown-header", "dnt",
+};
+static const char* methods[] = { "GET", "HEAD", "POST", "PUT", "DELETE", "OPTIONS", "PATCH", "BREW" };
+
+static const char* header_stream[TOKENS];
+static const char* method_stream[TOKENS];
+
+__attribute__((noinline)) int header_strcmp(const char* h) {
+    if (strcmp(h, "host") == 0) return 0;
+    if (strcmp(h, "user-agent") == 0) return 1;
+    if (strcmp(h, "accept") == 0) return 2;
+    if (strcmp(h, "accept-encoding") == 0) return 3;
+    if (strcmp(h, "accept-language") == 0) return 4;
+    if (strcmp(h, "connection") == 0) return 5;
+    if (strcmp(h, "content-type") == 0) return 6;
+    if (strcmp(h, "content-length") == 0) return 7;
+    if (strcmp(h, "cookie") == 0) return 8;
+    if (strcmp(h, "authorization") == 0) return 9;
+    if (strcmp(h, "cache-control") == 0) return 10;
+    if (strcmp(h, "if-none-match") == 0) return 11;
+    if (strcmp(h, "if-modified-since") == 0) return 12;
+    if (strcmp(h, "referer") == 0) return 13;
+    if (strcmp(h, "x-request-id") == 0) return 14;
+    if (strcmp(h, "x-forwarded-for") == 0) return 15;
+    if (strcmp(h, "upgrade-insecure-requests") == 0) return 16;
+    if (strcmp(h, "origin") == 0) return 17;
+    return -1;
+}
+
+__attribute__((noinline)) int header_match(const char* h) {
+    return let_strict(h) in(
+        is(str("host")) ? 0
+        : is(str("user-agent")) ? 1
+        : is(str("accept")) ? 2
+        : is(str("accept-encoding")) ? 3
+        : is(str("accept-language")) ? 4
+        : is(str("connection")) ? 5
+        : is(str("content-type")) ? 6
+        : is(str("content-length")) ? 7
+        : is(str("cookie")) ? 8
+        : is(str("authorization")) ? 9
+        : is(str("cache-control")) ? 10
+        : is(str("if-none-match")) ? 11
+        : is(str("if-modified-since")) ? 12
+        : is(str("referer")) ? 13
+        : is(str("x-request-id")) ? 14
+        : is(str("x-forwarded-for")) ? 15
+        : is(str("upgrade-insecure-requests")) ? 16
+        : is(str("origin")) ? 17
+        : -1
+    );
+}
+
+__attribute__((noinline)) int method_strcmp(const char* m) {
+    if (strcmp(m, "GET") == 0) return 0;
+    if (strcmp(m, "HEAD") == 0) return 1;
+    if (strcmp(m, "POST") == 0) return 2;
+    if (strcmp(m, "PUT") == 0) return 3;
+    if (strcmp(m, "DELETE") == 0) return 4;
+    if (strcmp(m, "OPTIONS") == 0) return 5;
+    if (strcmp(m, "PATCH") == 0) return 6;
+    return -1;
+}
+
+__attribute__((noinline)) int method_match(const char* m) {
+    return let_strict(m) in(
+        is(str("GET")) ? 0
+        : is(str("HEAD")) ? 1
+        : is(str("POST")) ? 2
+        : is(str("PUT")) ? 3
+        : is(str("DELETE")) ? 4
+        : is(str("OPTIONS")) ? 5
+        : is(str("PATCH")) ? 6
+        : -1
+    );
+}
+
+static void run(BenchSuite* suite, const char* name, const char** stream,
+                int (*baseline)(const char*), int (*matched)(const char*)) {
+    for (int i = 0; i < TOKENS; i++) {
+        if (baseline(stream[i]) != matched(stream[i])) {
+            printf("%s: mismatch on \"%s\"\n", name, stream[i]);
+            exit(1);
+        }
+    }
+    
+    char label[64];
+    snprintf(label, sizeof label, "%s/strcmp", name);
+    BENCH(suite, label, (uint64_t)TOKENS * ROUNDS) {
+        for (int r = 0; r < ROUNDS; r++)
+            for (int i = 0; i < TOKENS; i++) BENCH_DO_NOT_OPTIMIZE(baseline(stream[i]));
+    }
+    double baseline_ticks = bench_last(suite)->ticks_per_op;
+    
+    snprintf(label, sizeof label, "%s/str", name);
+    BENCH(suite, label, (uint64_t)TOKENS * ROUNDS) {
+        for (int r = 0; r < ROUNDS; r++)
+            for (int i = 0; i < TOKENS; i++) BENCH_DO_NOT_OPTIMIZE(matched(stream[i]));
+    }
+    double match_ticks = bench_last(suite)->ticks_per_op;
+    
+    printf("%-8s strcmp: %6.2f %s/lookup | str(): %6.2f %s/lookup | speedup %5.2fx\n",
+           name, baseline_ticks, BENCH_TICK_UNIT, match_ticks, BENCH_TICK_UNIT, baseline_ticks / match_ticks);
+}
+
+int main() {
+    printf("=== String Dispatch Benchmark ===\n");
+    BenchSuite suite = bench_suite("string_dispatch", NULL);
+    
+    srand(42);
+    for (int i = 0; i < TOKENS; i++) {
+        header_stream[i] = headers[rand() % (int)(sizeof headers / sizeof *headers)];
+        method_stream[i] = methods[rand() % (int)(sizeof methods / sizeof *methods)];
+    }
+    
+    run(&suite, "methods", method_stream, method_strcmp, method_match);
+    run(&suite, "headers", header_stream, header_strcmp, header_match);
+    
+    return bench_suite_end(&suite);
+}
@@ -0,0 +1,71 @@
+/*
+ * Hand-written C implementation of Result error propagation
+ * Every step checks the tag and returns the error by hand, with the
+ * same unlikely hint TRY() puts on the error edge
+ * compute_total() and compute_scaled() should assemble identically to the TRY() version
+ */
+
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "../match.h"
+
+__attribute__((noinline)) Result_int_ErrorCode parse_field(const char* text) {
+    if (*text == '\0') return err_int_ErrorCode(Error_InvalidInput);
+    int value = 0;
+    for (; *text; text++) {
+        if (*text < '0' || *text > '9') return err_int_ErrorCode(Error_InvalidInput);
+        value = value * 10 + (*text - '0');
+    }
+    return ok_int_ErrorCode(value);
+}
+
+__attribute__((noinline)) Result_int_ErrorCode check_range(int value) {
+    return value <= 1000 ? ok_int_ErrorCode(value) : err_int_ErrorCode(Error_OutOfBounds);
+}
+
+__attribute__((noinline)) Result_int_ErrorCode compute_total(const char* a, const char* b) {
+    Result_int_ErrorCode ra = parse_field(a);
+    if (__builtin_expect(ra.tag != Result_Ok, 0)) return ra;
+    Result_int_ErrorCode ca = check_range(ra.Ok);
+    if (__builtin_expect(ca.tag != Result_Ok, 0)) return ca;
+    Result_int_ErrorCode rb = parse_field(b);
+    if (__builtin_expect(rb.tag != Result_Ok, 0)) return rb;
+    Result_int_ErrorCode cb = check_range(rb.Ok);
+    if (__builtin_expect(cb.tag != Result_Ok, 0)) return cb;
+    return ok_int_ErrorCode(ca.Ok + cb.Ok);
+}
+
+__attribute__((noinline)) Result_long_ErrorCode compute_scaled(const char* a, long scale) {
+    Result_int_ErrorCode ra = parse_field(a);
+    if (__builtin_expect(ra.tag != Result_Ok, 0)) return err_long_ErrorCode(ra.Err);
+    return ok_long_ErrorCode(ra.Ok * scale);
+}
+
+int main() {
+    const int ITERATIONS = 10000000;
+    
+    printf("=== Hand-written Error Propagation Benchmark ===\n");
+    BenchSuite suite = bench_suite("try_propagation", "handwritten");
+    
+    const char* inputs[] = {"42", "17", "x9", "250", "", "5000", "7", "99"};
+    
+    // Benchmark 1: four-step pipeline, same Result type throughout
+    BENCH(&suite, "total", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) {
+            Result_int_ErrorCode r = compute_total(inputs[i & 7], inputs[(i + 3) & 7]);
+            if (r.tag == Result_Ok) BENCH_DO_NOT_OPTIMIZE(r.Ok);
+            else BENCH_DO_NOT_OPTIMIZE(r.Err);
+        }
+    }
+    
+    // Benchmark 2: error converted into a wider Result type
+    BENCH(&suite, "scaled", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) {
+            Result_long_ErrorCode r = compute_scaled(inputs[i & 7], 3);
+            if (r.tag == Result_Ok) BENCH_DO_NOT_OPTIMIZE(r.Ok);
+        }
+    }
+    
+    return bench_suite_end(&suite);
+}
@@ -0,0 +1,64 @@
+/*
+ * Pattern matching implementation of Result error propagation
+ * TRY() and TRY_OR() replace the hand-written tag checks
+ * compute_total() and compute_scaled() should assemble identically to the hand-written version
+ */
+
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "../match.h"
+
+__attribute__((noinline)) Result_int_ErrorCode parse_field(const char* text) {
+    if (*text == '\0') return err_int_ErrorCode(Error_InvalidInput);
+    int value = 0;
+    for (; *text; text++) {
+        if (*text < '0' || *text > '9') return err_int_ErrorCode(Error_InvalidInput);
+        value = value * 10 + (*text - '0');
+    }
+    return ok_int_ErrorCode(value);
+}
+
+__attribute__((noinline)) Result_int_ErrorCode check_range(int value) {
+    return value <= 1000 ? ok_int_ErrorCode(value) : err_int_ErrorCode(Error_OutOfBounds);
+}
+
+__attribute__((noinline)) Result_int_ErrorCode compute_total(const char* a, const char* b) {
+    int va = TRY(check_range(TRY(parse_field(a))));
+    int vb = TRY(check_range(TRY(parse_field(b))));
+    return ok_int_ErrorCode(va + vb);
+}
+
+__attribute__((noinline)) Result_long_ErrorCode compute_scaled(const char* a, long scale) {
+    return ok_long_ErrorCode(TRY_OR(parse_field(a), err_long_ErrorCode) * scale);
+}
+
+int main() {
+    const int ITERATIONS = 10000000;
+    
+    printf("=== Pattern Matching Error Propagation Benchmark ===\n");
+    BenchSuite suite = bench_suite("try_propagation", "match");
+    
+    const char* inputs[] = {"42", "17", "x9", "250", "", "5000", "7", "99"};
+    
+    // Benchmark 1: four-step pipeline, same Result type throughout
+    BENCH(&suite, "total", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) {
+            Result_int_ErrorCode r = compute_total(inputs[i & 7], inputs[(i + 3) & 7]);
+            match(&r) {
+                when(Result_Ok) { BENCH_DO_NOT_OPTIMIZE(r.Ok); }
+                when(Result_Err) { BENCH_DO_NOT_OPTIMIZE(r.Err); }
+            }
+        }
+    }
+    
+    // Benchmark 2: error converted into a wider Result type
+    BENCH(&suite, "scaled", ITERATIONS) {
+        for (int i = 0; i < ITERATIONS; i++) {
+            Result_long_ErrorCode r = compute_scaled(inputs[i & 7], 3);
+            BENCH_DO_NOT_OPTIMIZE(unwrap_or(&r, 0));
+        }
+    }
+    
+    return bench_suite_end(&suite);
+}
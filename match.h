@@ -93,11 +93,13 @@
  *   );
  * 
  * Tagged Union Notes:
- * - Unions must have tag as first field (uint32_t)
- * - Default assumes 8-byte offset to union (for padding)
- * - For packed structs, define VARIANT_UNION_OFFSET as 4 before including
- * - Use it(type) to access matched union value
- * - Legacy variant_value(type) is still supported
+ * - Unions need a member named tag; variant() reads it with that member's
+ *   offset and width, so packed structs and uint8_t/uint16_t tags work
+ * - Payloads are read at offsetof(_payload) in the subject's own type, so
+ *   compact, packed and over-aligned layouts need no configuration
+ * - Use it(type) to access matched union value, or when_bind(pattern, type, name)
+ *   to bind it to a typed local
+ * - Legacy variant_value(type) is the same as it(type)
  * 
  * ============================================================================
  * RESULT TYPES - Generic Error Handling
@@ -163,6 +165,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <limits.h>
 
 // ============================================================================
 // RESULT TYPES IMPLEMENTATION
@@ -174,6 +177,12 @@ typedef enum {
     Result_Err = 2
 } ResultTag;
 
+// Common option tags
+typedef enum {
+    Option_Some = 1,
+    Option_None = 2
+} OptionTag;
+
 // ============================================================================
 // Macro to create Result types for any type
 // ============================================================================
@@ -185,6 +194,7 @@ typedef enum {
         union { \
             TYPE Ok; \
             char* Err; \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
     } Result_##TYPE; \
     \
@@ -194,6 +204,13 @@ typedef enum {
     \
     static inline Result_##TYPE err_##TYPE(const char* msg) { \
         return (Result_##TYPE){Result_Err, 0, .Err = (char*)msg}; \
+    } \
+    \
+    /* Marks *out Ok and returns its payload slot, to be filled in place */ \
+    static inline TYPE* ok_##TYPE##_into(Result_##TYPE* out) { \
+        out->tag = Result_Ok; \
+        out->_padding = 0; \
+        return &out->Ok; \
     }
 
 // ============================================================================
@@ -207,6 +224,7 @@ typedef enum {
         union { \
             TYPE* Ok; \
             char* Err; \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
     } Result_##SUFFIX; \
     \
@@ -247,11 +265,46 @@ CreateResultPtr(size_t, size_t_ptr)
 #define is_ok(result_ptr) ((result_ptr)->tag == Result_Ok)
 #define is_err(result_ptr) ((result_ptr)->tag == Result_Err)
 
-#define unwrap_or(result_ptr, default_val) \
-    (is_ok(result_ptr) ? (result_ptr)->Ok : (default_val))
-
-#define unwrap_or_else(result_ptr, func) \
-    (is_ok(result_ptr) ? (result_ptr)->Ok : func((result_ptr)->Err))
+// The helpers below are statement expressions that bind result_ptr once, so
+// unwrap_or(cache_get(k), 0) calls cache_get() a single time; the
+// default and func are only evaluated on the Err path. With a plain variable
+// the temporary folds away and the code is the same as the ?: it replaces
+// (a struct payload of several hundred bytes may be copied once more on its
+// way out of the expression; read those through unwrap_ref()).
+#define unwrap_or(result_ptr, default_val) ({ \
+    __auto_type __match_r = (result_ptr); \
+    is_ok(__match_r) ? __match_r->Ok : (default_val); \
+})
+
+#define unwrap_or_else(result_ptr, func) ({ \
+    __auto_type __match_r = (result_ptr); \
+    is_ok(__match_r) ? __match_r->Ok : func(__match_r->Err); \
+})
+
+// By-reference access for large payloads: a pointer into the Result instead
+// of a copy of Ok. unwrap_ref() falls back to default_ptr, as_ref() to NULL.
+//   const Record* rec = unwrap_ref(&r, &empty_record);
+#define unwrap_ref(result_ptr, default_ptr) ({ \
+    __auto_type __match_r = (result_ptr); \
+    is_ok(__match_r) ? &__match_r->Ok : (default_ptr); \
+})
+
+#define as_ref(result_ptr) ({ \
+    __auto_type __match_r = (result_ptr); \
+    is_ok(__match_r) ? &__match_r->Ok : NULL; \
+})
+
+// OK_INIT(result_ptr, ...) - make *result_ptr Ok, building the payload in
+// place from an initializer list; together with ok_TYPE_into() this is the
+// copy-free way to produce a large Ok value:
+//   Result_Record r;
+//   OK_INIT(&r, .id = 7, .name = "seven");
+#define OK_INIT(result_ptr, ...) ({ \
+    __auto_type __match_out = (result_ptr); \
+    __match_out->tag = Result_Ok; \
+    __match_out->Ok = (__typeof__(__match_out->Ok)){ __VA_ARGS__ }; \
+    (void)0; \
+})
 
 // ============================================================================
 // Error handling utilities
@@ -267,31 +320,139 @@ CreateResultPtr(size_t, size_t_ptr)
 #define ERR_NETWORK_ERROR "Network error"
 #define ERR_TIMEOUT "Operation timed out"
 
+// The same errors as codes, for CreateResultCode types. error_message()
+// maps a code back to its ERR_* text when it is time to report it.
+typedef enum {
+    Error_NullPointer = 1,
+    Error_OutOfBounds,
+    Error_InvalidInput,
+    Error_AllocationFailed,
+    Error_FileNotFound,
+    Error_PermissionDenied,
+    Error_NetworkError,
+    Error_Timeout
+} ErrorCode;
+
+static inline const char* error_message(ErrorCode code) {
+    switch (code) {
+        case Error_NullPointer: return ERR_NULL_POINTER;
+        case Error_OutOfBounds: return ERR_OUT_OF_BOUNDS;
+        case Error_InvalidInput: return ERR_INVALID_INPUT;
+        case Error_AllocationFailed: return ERR_ALLOCATION_FAILED;
+        case Error_FileNotFound: return ERR_FILE_NOT_FOUND;
+        case Error_PermissionDenied: return ERR_PERMISSION_DENIED;
+        case Error_NetworkError: return ERR_NETWORK_ERROR;
+        case Error_Timeout: return ERR_TIMEOUT;
+    }
+    return "Unknown error";
+}
+
+// ============================================================================
+// Result types with error codes
+// ============================================================================
+
+// CreateResultCode(TYPE, ERRTYPE) - Result_TYPE_ERRTYPE whose error is a
+// small integer or enum instead of a char* message. Without the pointer the
+// struct is only as wide as the tag plus the larger of TYPE and ERRTYPE, so
+// it comes back in registers: Result_int_ErrorCode is 8 bytes (rax), and
+// Result_long_ErrorCode / Result_double_ErrorCode are 16 bytes (rax:rdx) on
+// x86-64 System V. The tag stays first and 32 bits wide, so
+// is_ok(), unwrap_or(), RESULT_MAP() and match(&r) when(Result_Ok) work as
+// for CreateResult.
+//   Result_int_ErrorCode parse_port(const char* s) {
+//       return s ? ok_int_ErrorCode(atoi(s)) : err_int_ErrorCode(Error_NullPointer);
+//   }
+#define CreateResultCode(TYPE, ERRTYPE) \
+    typedef struct { \
+        uint32_t tag; \
+        union { \
+            TYPE Ok; \
+            ERRTYPE Err; \
+            char _payload; /* names the payload offset, see it() */ \
+        }; \
+    } Result_##TYPE##_##ERRTYPE; \
+    \
+    static inline Result_##TYPE##_##ERRTYPE ok_##TYPE##_##ERRTYPE(TYPE val) { \
+        return (Result_##TYPE##_##ERRTYPE){Result_Ok, .Ok = val}; \
+    } \
+    \
+    static inline Result_##TYPE##_##ERRTYPE err_##TYPE##_##ERRTYPE(ERRTYPE code) { \
+        return (Result_##TYPE##_##ERRTYPE){Result_Err, .Err = code}; \
+    } \
+    \
+    static inline TYPE* ok_##TYPE##_##ERRTYPE##_into(Result_##TYPE##_##ERRTYPE* out) { \
+        out->tag = Result_Ok; \
+        return &out->Ok; \
+    }
+
+CreateResultCode(int, ErrorCode)
+CreateResultCode(long, ErrorCode)
+CreateResultCode(size_t, ErrorCode)
+CreateResultCode(double, ErrorCode)
+
 // ============================================================================
 // Chaining operations (monadic-style)
 // ============================================================================
 
-#define RESULT_MAP(result_ptr, func, result_type) \
-    (is_ok(result_ptr) ? ok_##result_type(func((result_ptr)->Ok)) : \
-                         err_##result_type((result_ptr)->Err))
+// Like the helpers above, these evaluate result_ptr once
+#define RESULT_MAP(result_ptr, func, result_type) ({ \
+    __auto_type __match_r = (result_ptr); \
+    is_ok(__match_r) ? ok_##result_type(func(__match_r->Ok)) : \
+                       err_##result_type(__match_r->Err); \
+})
 
-#define RESULT_AND_THEN(result_ptr, func) \
-    (is_ok(result_ptr) ? func((result_ptr)->Ok) : *result_ptr)
+#define RESULT_AND_THEN(result_ptr, func) ({ \
+    __auto_type __match_r = (result_ptr); \
+    is_ok(__match_r) ? func(__match_r->Ok) : *__match_r; \
+})
+
+// ============================================================================
+// Early-return propagation
+// ============================================================================
+
+// TRY(expr) - evaluate a Result once; on Err return it from the enclosing
+// function, otherwise yield its Ok value. The enclosing function must return
+// the same Result type. The Err edge is marked unlikely, so GCC moves the
+// return out of the straight-line Ok path; otherwise the code is the same as
+// writing if (r.tag != Result_Ok) return r; by hand.
+//   Result_int total(const char* a, const char* b) {
+//       return ok_int(TRY(parse_int(a)) + TRY(parse_int(b)));
+//   }
+#define TRY(expr) ({ \
+    __auto_type __match_try = (expr); \
+    if (__builtin_expect(__match_try.tag != Result_Ok, 0)) return __match_try; \
+    __match_try.Ok; \
+})
+
+// TRY_OR(expr, mapper) - as TRY(), but returns mapper(Err) so the error can
+// cross into another Result type. err_TYPE works as a mapper between message
+// Results, since they all carry a char*.
+//   Result_Point parse_point(const char* x, const char* y) {
+//       return ok_Point((Point){TRY_OR(parse_int(x), err_Point), TRY_OR(parse_int(y), err_Point)});
+//   }
+#define TRY_OR(expr, mapper) ({ \
+    __auto_type __match_try = (expr); \
+    if (__builtin_expect(__match_try.tag != Result_Ok, 0)) return mapper(__match_try.Err); \
+    __match_try.Ok; \
+})
 
 /*
  * Tagged Union Notes:
- * - Unions must have tag as first field (uint32_t)
- * - Default assumes 8-byte offset to union (for padding)
- * - For packed structs, define VARIANT_UNION_OFFSET as 4 before including
- * - Use it(type) to access matched union value
- * - Legacy variant_value(type) is still supported
+ * - Unions need a member named tag; variant() reads it with that member's
+ *   offset and width, so packed structs and uint8_t/uint16_t tags work
+ * - Payloads are read at offsetof(_payload) in the subject's own type, so
+ *   compact, packed and over-aligned layouts need no configuration
+ * - Use it(type) to access matched union value, or when_bind(pattern, type, name)
+ *   to bind it to a typed local
+ * - Legacy variant_value(type) is the same as it(type)
  */
 
-// The default union offset (8 bytes) works correctly for our tagged union types
-// due to struct alignment - uint32_t tag + 4 bytes padding + union
-// #ifndef VARIANT_UNION_OFFSET
-// #define VARIANT_UNION_OFFSET 4
-// #endif
+// Payload offset of the classic layout (uint32_t tag + 4 bytes padding). The
+// match macros no longer read through it; it remains for code that addresses
+// classic payloads by hand
+#ifndef VARIANT_UNION_OFFSET
+#define VARIANT_UNION_OFFSET 8
+#endif
 
 // ============================================================================
 // Core Infrastructure
@@ -301,53 +462,410 @@ CreateResultPtr(size_t, size_t_ptr)
 #define _GET_11TH_ARG(arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, ...) arg11
 #define COUNT_ARGS(...) _GET_11TH_ARG(__VA_ARGS__, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
 
+// Force inlining of the pattern evaluators so the constant pattern kind of
+// every arm folds away, even at call sites the optimizer would otherwise skip
+#define MATCH_INLINE static inline __attribute__((always_inline))
+
+// ============================================================================
+// Typed Patterns
+// ============================================================================
+
+// Every pattern is a small struct whose kind is a compile-time constant at the
+// use site. Once the evaluator is inlined the switch on the kind folds away and
+// only the comparison itself remains, even when the value is a runtime variable
+// (e.g. a threshold loaded from a config file).
+typedef enum {
+    MATCH_PAT_ANY = 0,   // wildcard
+    MATCH_PAT_EQ,        // literal
+    MATCH_PAT_GT,
+    MATCH_PAT_GE,
+    MATCH_PAT_LT,
+    MATCH_PAT_LE,
+    MATCH_PAT_NE,
+    MATCH_PAT_RANGE,     // exclusive range
+    MATCH_PAT_BETWEEN,   // inclusive range
+    MATCH_PAT_URANGE,    // exclusive range, unsigned compare
+    MATCH_PAT_UBETWEEN,  // inclusive range, unsigned compare
+    MATCH_PAT_VARIANT,   // tagged union variant
+    MATCH_PAT_FEQ,       // floating-point kinds: bounds live in flo/fhi
+    MATCH_PAT_FNE,
+    MATCH_PAT_FGT,
+    MATCH_PAT_FGE,
+    MATCH_PAT_FLT,
+    MATCH_PAT_FLE,
+    MATCH_PAT_FRANGE,
+    MATCH_PAT_FBETWEEN,
+    MATCH_PAT_FNAN,
+    MATCH_PAT_STR,       // string literal: lo = pointer, hi = length
+    MATCH_PAT_MASK,      // set of values in 0..63: lo = bitmask
+    MATCH_PAT_SET32,     // set of int32 values: lo = pointer to values, hi = count
+    MATCH_PAT_SET        // any other set: lo = pointer to int64 values, hi = count
+} MatchPatternKind;
+
+#define MATCH_PAT_IS_FLOAT(kind) ((kind) >= MATCH_PAT_FEQ && (kind) <= MATCH_PAT_FNAN)
+
+// Bounds are always 64 bits wide so range patterns never truncate, whatever
+// the pointer width of the target. Floating-point kinds keep their bounds as
+// doubles in the same storage.
+typedef struct {
+    MatchPatternKind kind;
+    union {
+        int64_t lo;      // value, lower bound or variant tag
+        double flo;
+    };
+    union {
+        int64_t hi;      // upper bound for ranges
+        double fhi;
+    };
+} MatchPattern;
+
+#define MATCH_PATTERN(kind, lo, hi) ((MatchPattern){(kind), {(int64_t)(lo)}, {(int64_t)(hi)}})
+#define MATCH_FPATTERN(k, low, high) \
+    ((MatchPattern){.kind = (k), .flo = (double)(low), .fhi = (double)(high)})
+
+// A string subject that carries its own length, e.g. a token in a request
+// buffer that is not NUL-terminated
+typedef struct {
+    const char *ptr;
+    size_t len;
+} MatchStr;
+
+#define str_view(p, n) ((MatchStr){(p), (size_t)(n)})
+
+// Length of a char * subject, measured only if a str() arm is reached
+#define MATCH_STR_CSTR ((size_t)-1)
+
 // Wildcard pattern
-#define __ ((void*)0x1DEADBEEF)
-#define IS_WILDCARD(v) ((const void*)(v) == __)
+#define __ MATCH_PATTERN(MATCH_PAT_ANY, 0, 0)
+#define IS_WILDCARD(p) ((p).kind == MATCH_PAT_ANY)
 
 // ============================================================================
 // Pattern Creation Macros
 // ============================================================================
 
-// Inequality patterns - encode type in upper bits, value in lower bits
-#define gt(val) ((void*)(0x1000000000000000ULL | ((uintptr_t)(val) & 0x0FFFFFFFFFFFFFFFULL)))
-#define ge(val) ((void*)(0x2000000000000000ULL | ((uintptr_t)(val) & 0x0FFFFFFFFFFFFFFFULL)))
-#define lt(val) ((void*)(0x3000000000000000ULL | ((uintptr_t)(val) & 0x0FFFFFFFFFFFFFFFULL)))
-#define le(val) ((void*)(0x4000000000000000ULL | ((uintptr_t)(val) & 0x0FFFFFFFFFFFFFFFULL)))
-#define ne(val) ((void*)(0x5000000000000000ULL | ((uintptr_t)(val) & 0x0FFFFFFFFFFFFFFFULL)))
+// Inequality patterns
+#define gt(val) MATCH_PATTERN(MATCH_PAT_GT, (val), 0)
+#define ge(val) MATCH_PATTERN(MATCH_PAT_GE, (val), 0)
+#define lt(val) MATCH_PATTERN(MATCH_PAT_LT, (val), 0)
+#define le(val) MATCH_PATTERN(MATCH_PAT_LE, (val), 0)
+#define ne(val) MATCH_PATTERN(MATCH_PAT_NE, (val), 0)
+
+// Range patterns
+// Bounds follow C's usual arithmetic conversions: if they promote to a 64-bit
+// unsigned type (e.g. between(0, UINT64_MAX) or range(1ULL << 63, ~0ULL)) the
+// subject is compared unsigned, otherwise signed. urange()/ubetween() force
+// the unsigned compare for bounds that happen to be written as signed.
+#define _MATCH_RANGE_KIND(low, high, signed_kind, unsigned_kind) \
+    _Generic((low) + (high), \
+        unsigned long: (unsigned_kind), \
+        unsigned long long: (unsigned_kind), \
+        default: (signed_kind))
+#define range(low, high) \
+    MATCH_PATTERN(_MATCH_RANGE_KIND(low, high, MATCH_PAT_RANGE, MATCH_PAT_URANGE), (low), (high))
+#define between(low, high) \
+    MATCH_PATTERN(_MATCH_RANGE_KIND(low, high, MATCH_PAT_BETWEEN, MATCH_PAT_UBETWEEN), (low), (high))
+#define urange(low, high) MATCH_PATTERN(MATCH_PAT_URANGE, (low), (high))
+#define ubetween(low, high) MATCH_PATTERN(MATCH_PAT_UBETWEEN, (low), (high))
+
+// Floating-point patterns - compare as double (a single ucomisd per bound, no
+// integer round-trip). Every ordered pattern fails for NaN, exactly like the
+// C operators: fne() matches NaN, fnan matches only NaN. Plain float literals
+// such as when(0.5) become feq().
+#define feq(val) MATCH_FPATTERN(MATCH_PAT_FEQ, (val), 0)
+#define fne(val) MATCH_FPATTERN(MATCH_PAT_FNE, (val), 0)
+#define fgt(val) MATCH_FPATTERN(MATCH_PAT_FGT, (val), 0)
+#define fge(val) MATCH_FPATTERN(MATCH_PAT_FGE, (val), 0)
+#define flt(val) MATCH_FPATTERN(MATCH_PAT_FLT, (val), 0)
+#define fle(val) MATCH_FPATTERN(MATCH_PAT_FLE, (val), 0)
+#define frange(low, high) MATCH_FPATTERN(MATCH_PAT_FRANGE, (low), (high))
+#define fbetween(low, high) MATCH_FPATTERN(MATCH_PAT_FBETWEEN, (low), (high))
+#define fnan MATCH_FPATTERN(MATCH_PAT_FNAN, 0, 0)
+
+// String patterns - str("GET") matches a char * subject holding "GET", or a
+// str_view(ptr, len) subject with the same bytes (no terminator needed). The
+// argument must be a string literal so its length is a compile-time constant.
+#define str(lit) MATCH_PATTERN(MATCH_PAT_STR, (intptr_t)("" lit), sizeof("" lit) - 1)
+
+// Set membership - any_of(v1, ..., vN) matches any of up to 16 constant
+// values. Sets that fit in 0..63 become a 64-bit mask tested with one shift
+// (a single bt); any other set is compared with SIMD against a packed
+// constant array (the subject is broadcast once, then 4-8 int32 or 2-4 int64
+// values per compare). Only the array the chosen kind needs is emitted.
+#define any_of(...) MATCH_ANY_OF(MATCH_COUNT_SET(__VA_ARGS__), __VA_ARGS__)
+#define MATCH_ANY_OF(N, ...) \
+    ({ static const int64_t __any_of_set[] = { __VA_ARGS__, MATCH_SET_PAD(__VA_ARGS__) }; \
+       static const int32_t __any_of_set32[] = { MATCH_SET_INT32(N, __VA_ARGS__), \
+                                                 MATCH_SET_INT32(7, MATCH_SET_PAD(__VA_ARGS__)) }; \
+       (MATCH_SET_SMALL(N, __VA_ARGS__)) \
+           ? MATCH_PATTERN(MATCH_PAT_MASK, MATCH_SET_MASK(N, __VA_ARGS__), 0) \
+           : (MATCH_SET_NARROW(N, __VA_ARGS__)) \
+           ? MATCH_PATTERN(MATCH_PAT_SET32, (intptr_t)__any_of_set32, (N)) \
+           : MATCH_PATTERN(MATCH_PAT_SET, (intptr_t)__any_of_set, (N)); })
+// Seven copies of the first value let the SIMD loop read whole vectors
+#define MATCH_SET_PAD(v1, ...) (v1), (v1), (v1), (v1), (v1), (v1), (v1)
+#define MATCH_SET_FITS(v) ((uint64_t)(int64_t)(v) < 64)
+#define MATCH_SET_FITS32(v) ((int64_t)(v) >= INT32_MIN && (int64_t)(v) <= INT32_MAX)
+#define MATCH_SET_BIT(v) (MATCH_SET_FITS(v) ? UINT64_C(1) << ((v) & 63) : 0)
+
+#define _GET_17TH_ARG(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, ...) _17
+#define MATCH_COUNT_SET(...) _GET_17TH_ARG(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define MATCH_SET_SMALL(N, ...) MATCH_SET_SMALL_(N, __VA_ARGS__)
+#define MATCH_SET_SMALL_(N, ...) MATCH_SET_SMALL_##N(__VA_ARGS__)
+#define MATCH_SET_MASK(N, ...) MATCH_SET_MASK_(N, __VA_ARGS__)
+#define MATCH_SET_MASK_(N, ...) MATCH_SET_MASK_##N(__VA_ARGS__)
+
+#define MATCH_SET_SMALL_1(v1) MATCH_SET_FITS(v1)
+#define MATCH_SET_SMALL_2(v1, v2) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_1(v2)
+#define MATCH_SET_SMALL_3(v1, v2, v3) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_2(v2, v3)
+#define MATCH_SET_SMALL_4(v1, v2, v3, v4) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_3(v2, v3, v4)
+#define MATCH_SET_SMALL_5(v1, v2, v3, v4, v5) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_4(v2, v3, v4, v5)
+#define MATCH_SET_SMALL_6(v1, v2, v3, v4, v5, v6) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_5(v2, v3, v4, v5, v6)
+#define MATCH_SET_SMALL_7(v1, v2, v3, v4, v5, v6, v7) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_6(v2, v3, v4, v5, v6, v7)
+#define MATCH_SET_SMALL_8(v1, v2, v3, v4, v5, v6, v7, v8) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_7(v2, v3, v4, v5, v6, v7, v8)
+#define MATCH_SET_SMALL_9(v1, v2, v3, v4, v5, v6, v7, v8, v9) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_8(v2, v3, v4, v5, v6, v7, v8, v9)
+#define MATCH_SET_SMALL_10(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_9(v2, v3, v4, v5, v6, v7, v8, v9, v10)
+#define MATCH_SET_SMALL_11(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_10(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11)
+#define MATCH_SET_SMALL_12(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_11(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12)
+#define MATCH_SET_SMALL_13(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_12(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13)
+#define MATCH_SET_SMALL_14(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_13(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14)
+#define MATCH_SET_SMALL_15(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_14(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15)
+#define MATCH_SET_SMALL_16(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15, v16) MATCH_SET_FITS(v1) && MATCH_SET_SMALL_15(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15, v16)
+
+#define MATCH_SET_MASK_1(v1) MATCH_SET_BIT(v1)
+#define MATCH_SET_MASK_2(v1, v2) MATCH_SET_BIT(v1) | MATCH_SET_MASK_1(v2)
+#define MATCH_SET_MASK_3(v1, v2, v3) MATCH_SET_BIT(v1) | MATCH_SET_MASK_2(v2, v3)
+#define MATCH_SET_MASK_4(v1, v2, v3, v4) MATCH_SET_BIT(v1) | MATCH_SET_MASK_3(v2, v3, v4)
+#define MATCH_SET_MASK_5(v1, v2, v3, v4, v5) MATCH_SET_BIT(v1) | MATCH_SET_MASK_4(v2, v3, v4, v5)
+#define MATCH_SET_MASK_6(v1, v2, v3, v4, v5, v6) MATCH_SET_BIT(v1) | MATCH_SET_MASK_5(v2, v3, v4, v5, v6)
+#define MATCH_SET_MASK_7(v1, v2, v3, v4, v5, v6, v7) MATCH_SET_BIT(v1) | MATCH_SET_MASK_6(v2, v3, v4, v5, v6, v7)
+#define MATCH_SET_MASK_8(v1, v2, v3, v4, v5, v6, v7, v8) MATCH_SET_BIT(v1) | MATCH_SET_MASK_7(v2, v3, v4, v5, v6, v7, v8)
+#define MATCH_SET_MASK_9(v1, v2, v3, v4, v5, v6, v7, v8, v9) MATCH_SET_BIT(v1) | MATCH_SET_MASK_8(v2, v3, v4, v5, v6, v7, v8, v9)
+#define MATCH_SET_MASK_10(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) MATCH_SET_BIT(v1) | MATCH_SET_MASK_9(v2, v3, v4, v5, v6, v7, v8, v9, v10)
+#define MATCH_SET_MASK_11(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) MATCH_SET_BIT(v1) | MATCH_SET_MASK_10(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11)
+#define MATCH_SET_MASK_12(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12) MATCH_SET_BIT(v1) | MATCH_SET_MASK_11(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12)
+#define MATCH_SET_MASK_13(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13) MATCH_SET_BIT(v1) | MATCH_SET_MASK_12(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13)
+#define MATCH_SET_MASK_14(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14) MATCH_SET_BIT(v1) | MATCH_SET_MASK_13(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14)
+#define MATCH_SET_MASK_15(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15) MATCH_SET_BIT(v1) | MATCH_SET_MASK_14(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15)
+#define MATCH_SET_MASK_16(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15, v16) MATCH_SET_BIT(v1) | MATCH_SET_MASK_15(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15, v16)
+
+#define MATCH_SET_NARROW(N, ...) MATCH_SET_NARROW_(N, __VA_ARGS__)
+#define MATCH_SET_NARROW_(N, ...) MATCH_SET_NARROW_##N(__VA_ARGS__)
+#define MATCH_SET_INT32(N, ...) MATCH_SET_INT32_(N, __VA_ARGS__)
+#define MATCH_SET_INT32_(N, ...) MATCH_SET_INT32_##N(__VA_ARGS__)
+
+#define MATCH_SET_NARROW_1(v1) MATCH_SET_FITS32(v1)
+#define MATCH_SET_NARROW_2(v1, v2) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_1(v2)
+#define MATCH_SET_NARROW_3(v1, v2, v3) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_2(v2, v3)
+#define MATCH_SET_NARROW_4(v1, v2, v3, v4) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_3(v2, v3, v4)
+#define MATCH_SET_NARROW_5(v1, v2, v3, v4, v5) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_4(v2, v3, v4, v5)
+#define MATCH_SET_NARROW_6(v1, v2, v3, v4, v5, v6) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_5(v2, v3, v4, v5, v6)
+#define MATCH_SET_NARROW_7(v1, v2, v3, v4, v5, v6, v7) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_6(v2, v3, v4, v5, v6, v7)
+#define MATCH_SET_NARROW_8(v1, v2, v3, v4, v5, v6, v7, v8) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_7(v2, v3, v4, v5, v6, v7, v8)
+#define MATCH_SET_NARROW_9(v1, v2, v3, v4, v5, v6, v7, v8, v9) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_8(v2, v3, v4, v5, v6, v7, v8, v9)
+#define MATCH_SET_NARROW_10(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_9(v2, v3, v4, v5, v6, v7, v8, v9, v10)
+#define MATCH_SET_NARROW_11(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_10(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11)
+#define MATCH_SET_NARROW_12(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_11(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12)
+#define MATCH_SET_NARROW_13(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_12(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13)
+#define MATCH_SET_NARROW_14(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_13(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14)
+#define MATCH_SET_NARROW_15(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_14(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15)
+#define MATCH_SET_NARROW_16(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15, v16) MATCH_SET_FITS32(v1) && MATCH_SET_NARROW_15(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15, v16)
+
+#define MATCH_SET_INT32_1(v1) (int32_t)(v1)
+#define MATCH_SET_INT32_2(v1, v2) (int32_t)(v1), MATCH_SET_INT32_1(v2)
+#define MATCH_SET_INT32_3(v1, v2, v3) (int32_t)(v1), MATCH_SET_INT32_2(v2, v3)
+#define MATCH_SET_INT32_4(v1, v2, v3, v4) (int32_t)(v1), MATCH_SET_INT32_3(v2, v3, v4)
+#define MATCH_SET_INT32_5(v1, v2, v3, v4, v5) (int32_t)(v1), MATCH_SET_INT32_4(v2, v3, v4, v5)
+#define MATCH_SET_INT32_6(v1, v2, v3, v4, v5, v6) (int32_t)(v1), MATCH_SET_INT32_5(v2, v3, v4, v5, v6)
+#define MATCH_SET_INT32_7(v1, v2, v3, v4, v5, v6, v7) (int32_t)(v1), MATCH_SET_INT32_6(v2, v3, v4, v5, v6, v7)
+#define MATCH_SET_INT32_8(v1, v2, v3, v4, v5, v6, v7, v8) (int32_t)(v1), MATCH_SET_INT32_7(v2, v3, v4, v5, v6, v7, v8)
+#define MATCH_SET_INT32_9(v1, v2, v3, v4, v5, v6, v7, v8, v9) (int32_t)(v1), MATCH_SET_INT32_8(v2, v3, v4, v5, v6, v7, v8, v9)
+#define MATCH_SET_INT32_10(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10) (int32_t)(v1), MATCH_SET_INT32_9(v2, v3, v4, v5, v6, v7, v8, v9, v10)
+#define MATCH_SET_INT32_11(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11) (int32_t)(v1), MATCH_SET_INT32_10(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11)
+#define MATCH_SET_INT32_12(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12) (int32_t)(v1), MATCH_SET_INT32_11(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12)
+#define MATCH_SET_INT32_13(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13) (int32_t)(v1), MATCH_SET_INT32_12(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13)
+#define MATCH_SET_INT32_14(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14) (int32_t)(v1), MATCH_SET_INT32_13(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14)
+#define MATCH_SET_INT32_15(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15) (int32_t)(v1), MATCH_SET_INT32_14(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15)
+#define MATCH_SET_INT32_16(v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15, v16) (int32_t)(v1), MATCH_SET_INT32_15(v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15, v16)
+
+// Union variant patterns - match on the subject's tag member. The tag's
+// offset and width are read from the subject's own type at the match site
+// (offsetof/sizeof on its tag member) and travel in the pattern's hi word, so
+// a uint8_t tag, a tag placed after the payload or a packed struct match just
+// like the classic uint32_t tag at offset 0. For niche options (no stored
+// tag, see CreateOptionPtrNiche) lo holds the None sentinel instead and the
+// pattern asks whether the payload equals it.
+#define variant(tag) MATCH_VARIANT(__match_subject, tag)
+#define MATCH_VARIANT(s, t) \
+    MATCH_PATTERN(MATCH_PAT_VARIANT, \
+                  MATCH_IS_NICHE((s)->tag) ? (int64_t)MATCH_NICHE_BITS(MATCH_NICHE_VIEW(s)) \
+                                           : (int64_t)(uint32_t)(t), \
+                  MATCH_TAG_LAYOUT(s) | ((int64_t)((uint32_t)(t) == (uint32_t)Option_None) << 25))
+
+// Tag layout packed into one word: bits 0-15 offset, bits 16-23 width in
+// bytes, bit 24 set for a niche tag, bit 25 set when a niche pattern wants
+// None (the sentinel) rather than Some
+#define MATCH_TAG_LAYOUT(p) \
+    ((int64_t)offsetof(__typeof__(*(p)), tag) | ((int64_t)sizeof((p)->tag) << 16) | \
+     ((int64_t)MATCH_IS_NICHE((p)->tag) << 24))
+#define MATCH_TAG_OFFSET(layout) ((size_t)((layout) & 0xFFFF))
+#define MATCH_TAG_WIDTH(layout) ((size_t)(((layout) >> 16) & 0xFF))
+#define MATCH_TAG_NICHE(layout) ((int)(((layout) >> 24) & 1))
+#define MATCH_TAG_WANTS_NONE(layout) ((int)(((layout) >> 25) & 1))
+
+// Every match()/let() arm declares its subject as __match_subject (see
+// MATCH_TEST). Anywhere else - patterns built in a table, evaluate_pattern()
+// called by hand - variant() falls back to this classic layout: a uint32_t
+// tag at offset 0. Only the type is used; the pointer is never read.
+typedef struct { uint32_t tag; } MatchTagged;
+static MatchTagged *const __match_subject __attribute__((unused)) = 0;
+
+// Niche options store no tag: None is a payload value that can never be a
+// valid Some (NULL for pointers). Their tag member is the payload's own bits,
+// typed as one of these wrappers so _Generic can tell a niche apart from a
+// real tag (and so opt.tag == Option_Some does not compile on a niche).
+typedef struct { uint8_t bits; } MatchNiche8;
+typedef struct { uint16_t bits; } MatchNiche16;
+typedef struct { uint32_t bits; } MatchNiche32;
+typedef struct { uint64_t bits; } MatchNiche64;
+
+#define MATCH_IS_NICHE(tag) \
+    _Generic((tag), MatchNiche8: 1, MatchNiche16: 1, MatchNiche32: 1, MatchNiche64: 1, default: 0)
+
+// The sentinel's bits (zero-extended from the payload width) are carried by
+// the dimensions of a zero-length member, 16 bits per dimension, so they
+// cost no storage and sizeof reads them back as a constant. It must be the
+// first member: anywhere else the x86-64 ABI would pass the option in memory
+// instead of a register.
+#define MATCH_NICHE_FIELDS(bits) \
+    struct { \
+        char q0[((uint64_t)(bits) & 0xFFFF) + 1]; \
+        char q1[(((uint64_t)(bits) >> 16) & 0xFFFF) + 1]; \
+        char q2[(((uint64_t)(bits) >> 32) & 0xFFFF) + 1]; \
+        char q3[(((uint64_t)(bits) >> 48) & 0xFFFF) + 1]; \
+    } _niche[0];
+#define MATCH_NICHE_BITS(p) \
+    ((uint64_t)(sizeof((p)->_niche[0].q0) - 1) | \
+     ((uint64_t)(sizeof((p)->_niche[0].q1) - 1) << 16) | \
+     ((uint64_t)(sizeof((p)->_niche[0].q2) - 1) << 32) | \
+     ((uint64_t)(sizeof((p)->_niche[0].q3) - 1) << 48))
+
+// p itself if it is a niche option, otherwise a stand-in that has _niche, so
+// MATCH_NICHE_BITS() compiles for every subject
+typedef struct { MATCH_NICHE_FIELDS(0) } MatchNicheNone;
+#define MATCH_NICHE_VIEW(p) _Generic((p)->tag, \
+    MatchNiche8: (p), MatchNiche16: (p), MatchNiche32: (p), MatchNiche64: (p), \
+    default: (MatchNicheNone*)0)
+
+// Tag of any Option, niche or not, widened to 64 bits
+MATCH_INLINE uint64_t match_load_tag(const void *tag, size_t width) {
+    switch (width) {
+        case 1: { uint8_t t; __builtin_memcpy(&t, tag, 1); return t; }
+        case 2: { uint16_t t; __builtin_memcpy(&t, tag, 2); return t; }
+        case 8: { uint64_t t; __builtin_memcpy(&t, tag, 8); return t; }
+        default: { uint32_t t; __builtin_memcpy(&t, tag, 4); return t; }
+    }
+}
 
-// Range patterns - encode low and high values (16-bit signed integers with sign extension)
-#define range(low, high) ((void*)(0x6000000000000000ULL | (((uint64_t)((uint16_t)(low)) << 32) | ((uint16_t)(high)))))
-#define between(low, high) ((void*)(0x7000000000000000ULL | (((uint64_t)((uint16_t)(low)) << 32) | ((uint16_t)(high)))))
+MATCH_INLINE void match_store_tag(void *tag, size_t width, uint64_t value) {
+    switch (width) {
+        case 1: { uint8_t t = (uint8_t)value; __builtin_memcpy(tag, &t, 1); break; }
+        case 2: { uint16_t t = (uint16_t)value; __builtin_memcpy(tag, &t, 2); break; }
+        case 8: { __builtin_memcpy(tag, &value, 8); break; }
+        default: { uint32_t t = (uint32_t)value; __builtin_memcpy(tag, &t, 4); break; }
+    }
+}
 
-// Union variant patterns - encode tag only, always extract value
-#define variant(tag) ((void*)(0x8000000000000000ULL | (((uint64_t)((uint32_t)(tag)) << 16) | 1)))
+// Is the option at p in state t (Option_Some or Option_None)? A niche option
+// answers with one compare of the payload against its sentinel.
+#define MATCH_OPTION_IS(p, t) \
+    (MATCH_IS_NICHE((p)->tag) \
+        ? (match_load_tag(&(p)->tag, sizeof((p)->tag)) == MATCH_NICHE_BITS(MATCH_NICHE_VIEW(p))) \
+              == ((t) == Option_None) \
+        : match_load_tag(&(p)->tag, sizeof((p)->tag)) == (uint64_t)(t))
 
 // ============================================================================
-// Pattern Decoding Utilities
+// Layout Registry for Auto-Mode Literals
 // ============================================================================
 
-#define GET_PATTERN_TYPE(p) (((uintptr_t)(p) >> 60) & 0xF)
-#define GET_PATTERN_VALUE(p) ((intptr_t)((uintptr_t)(p) & 0x0FFFFFFFFFFFFFFFULL))
-#define GET_RANGE_LOW(p) ((int16_t)(((uintptr_t)(p) >> 32) & 0xFFFF))
-#define GET_RANGE_HIGH(p) ((int16_t)((uintptr_t)(p) & 0xFFFF))
-#define GET_VARIANT_TAG(p) ((uint32_t)(((uintptr_t)(p) >> 16) & 0xFFFFFFFF))
-#define GET_VARIANT_EXTRACT(p) (((uintptr_t)(p)) & 0x1)
+// Auto mode resolves when(Option_Some) or when(Ev_Count) on &subject by
+// reading a uint32_t tag at offset 0. Niche options have no tag and compact
+// tag unions keep theirs after the payload, so that guess would read payload
+// bits. Their generators therefore claim a numbered slot: the generated type
+// is struct MatchSlotN, and match_slot_N records its tag layout (and niche
+// sentinel). At a match site, _Generic finds the subject's slot and literal
+// tags are rewritten into the type's own variant() pattern. The slot number
+// is the generator's __COUNTER__ value, which nothing else in this header
+// takes, so it counts these types plus any __COUNTER__ uses of the including
+// code. MATCH_SLOTS is fixed by the two 64-entry lists below.
+#define MATCH_SLOTS 64
+
+typedef struct {
+    int64_t bits;     // niche sentinel, see MATCH_NICHE_BITS
+    int64_t layout;   // see MATCH_TAG_LAYOUT
+} MatchSlotInfo;
+
+// One incomplete struct and one zero record per slot; a generator completes both
+#define MATCH_SLOT_DECLARE(k) \
+    struct MatchSlot##k; static const MatchSlotInfo match_slot_##k __attribute__((unused));
+MATCH_SLOT_DECLARE(0) MATCH_SLOT_DECLARE(1) MATCH_SLOT_DECLARE(2) MATCH_SLOT_DECLARE(3) MATCH_SLOT_DECLARE(4) MATCH_SLOT_DECLARE(5) MATCH_SLOT_DECLARE(6) MATCH_SLOT_DECLARE(7)
+MATCH_SLOT_DECLARE(8) MATCH_SLOT_DECLARE(9) MATCH_SLOT_DECLARE(10) MATCH_SLOT_DECLARE(11) MATCH_SLOT_DECLARE(12) MATCH_SLOT_DECLARE(13) MATCH_SLOT_DECLARE(14) MATCH_SLOT_DECLARE(15)
+MATCH_SLOT_DECLARE(16) MATCH_SLOT_DECLARE(17) MATCH_SLOT_DECLARE(18) MATCH_SLOT_DECLARE(19) MATCH_SLOT_DECLARE(20) MATCH_SLOT_DECLARE(21) MATCH_SLOT_DECLARE(22) MATCH_SLOT_DECLARE(23)
+MATCH_SLOT_DECLARE(24) MATCH_SLOT_DECLARE(25) MATCH_SLOT_DECLARE(26) MATCH_SLOT_DECLARE(27) MATCH_SLOT_DECLARE(28) MATCH_SLOT_DECLARE(29) MATCH_SLOT_DECLARE(30) MATCH_SLOT_DECLARE(31)
+MATCH_SLOT_DECLARE(32) MATCH_SLOT_DECLARE(33) MATCH_SLOT_DECLARE(34) MATCH_SLOT_DECLARE(35) MATCH_SLOT_DECLARE(36) MATCH_SLOT_DECLARE(37) MATCH_SLOT_DECLARE(38) MATCH_SLOT_DECLARE(39)
+MATCH_SLOT_DECLARE(40) MATCH_SLOT_DECLARE(41) MATCH_SLOT_DECLARE(42) MATCH_SLOT_DECLARE(43) MATCH_SLOT_DECLARE(44) MATCH_SLOT_DECLARE(45) MATCH_SLOT_DECLARE(46) MATCH_SLOT_DECLARE(47)
+MATCH_SLOT_DECLARE(48) MATCH_SLOT_DECLARE(49) MATCH_SLOT_DECLARE(50) MATCH_SLOT_DECLARE(51) MATCH_SLOT_DECLARE(52) MATCH_SLOT_DECLARE(53) MATCH_SLOT_DECLARE(54) MATCH_SLOT_DECLARE(55)
+MATCH_SLOT_DECLARE(56) MATCH_SLOT_DECLARE(57) MATCH_SLOT_DECLARE(58) MATCH_SLOT_DECLARE(59) MATCH_SLOT_DECLARE(60) MATCH_SLOT_DECLARE(61) MATCH_SLOT_DECLARE(62) MATCH_SLOT_DECLARE(63)
+
+#define MATCH_SLOT_STRUCT(k) MATCH_SLOT_STRUCT_(k)
+#define MATCH_SLOT_STRUCT_(k) MatchSlot##k
+#define MATCH_SLOT_REGISTER(k, type) MATCH_SLOT_REGISTER_(k, type)
+#define MATCH_SLOT_REGISTER_(k, type) \
+    _Static_assert(k < MATCH_SLOTS, "out of layout slots: a translation unit holds 64 niche " \
+                   "options and compact/packed tag unions, counting its own __COUNTER__ uses; " \
+                   "define these types before code that uses __COUNTER__"); \
+    static const MatchSlotInfo match_slot_##k __attribute__((unused)) = { \
+        (int64_t)MATCH_NICHE_BITS(MATCH_NICHE_VIEW((type*)0)), MATCH_TAG_LAYOUT((type*)0) };
+
+#define MATCH_SLOT_CASE(k) \
+    struct MatchSlot##k *: &match_slot_##k, const struct MatchSlot##k *: &match_slot_##k
+#define MATCH_SLOT_OF(s) \
+    _Generic((s), \
+    MATCH_SLOT_CASE(0), MATCH_SLOT_CASE(1), MATCH_SLOT_CASE(2), MATCH_SLOT_CASE(3), MATCH_SLOT_CASE(4), MATCH_SLOT_CASE(5), MATCH_SLOT_CASE(6), MATCH_SLOT_CASE(7), \
+    MATCH_SLOT_CASE(8), MATCH_SLOT_CASE(9), MATCH_SLOT_CASE(10), MATCH_SLOT_CASE(11), MATCH_SLOT_CASE(12), MATCH_SLOT_CASE(13), MATCH_SLOT_CASE(14), MATCH_SLOT_CASE(15), \
+    MATCH_SLOT_CASE(16), MATCH_SLOT_CASE(17), MATCH_SLOT_CASE(18), MATCH_SLOT_CASE(19), MATCH_SLOT_CASE(20), MATCH_SLOT_CASE(21), MATCH_SLOT_CASE(22), MATCH_SLOT_CASE(23), \
+    MATCH_SLOT_CASE(24), MATCH_SLOT_CASE(25), MATCH_SLOT_CASE(26), MATCH_SLOT_CASE(27), MATCH_SLOT_CASE(28), MATCH_SLOT_CASE(29), MATCH_SLOT_CASE(30), MATCH_SLOT_CASE(31), \
+    MATCH_SLOT_CASE(32), MATCH_SLOT_CASE(33), MATCH_SLOT_CASE(34), MATCH_SLOT_CASE(35), MATCH_SLOT_CASE(36), MATCH_SLOT_CASE(37), MATCH_SLOT_CASE(38), MATCH_SLOT_CASE(39), \
+    MATCH_SLOT_CASE(40), MATCH_SLOT_CASE(41), MATCH_SLOT_CASE(42), MATCH_SLOT_CASE(43), MATCH_SLOT_CASE(44), MATCH_SLOT_CASE(45), MATCH_SLOT_CASE(46), MATCH_SLOT_CASE(47), \
+    MATCH_SLOT_CASE(48), MATCH_SLOT_CASE(49), MATCH_SLOT_CASE(50), MATCH_SLOT_CASE(51), MATCH_SLOT_CASE(52), MATCH_SLOT_CASE(53), MATCH_SLOT_CASE(54), MATCH_SLOT_CASE(55), \
+    MATCH_SLOT_CASE(56), MATCH_SLOT_CASE(57), MATCH_SLOT_CASE(58), MATCH_SLOT_CASE(59), MATCH_SLOT_CASE(60), MATCH_SLOT_CASE(61), MATCH_SLOT_CASE(62), MATCH_SLOT_CASE(63), \
+        default: (const MatchSlotInfo*)0)
+
+// The arm's pattern as auto mode should see it: literals on a registered
+// subject become variant() patterns; everything else is left alone
+#define MATCH_AUTO_LAYOUT(strict, s, pat) match_auto_layout(strict, pat, MATCH_SLOT_OF(s))
+
+MATCH_INLINE MatchPattern match_auto_layout(int strict, MatchPattern pattern, const MatchSlotInfo *slot) {
+    if (strict || !slot || pattern.kind != MATCH_PAT_EQ) return pattern;
+    if (MATCH_TAG_NICHE(slot->layout)) {
+        if (pattern.lo == Option_Some) return MATCH_PATTERN(MATCH_PAT_VARIANT, slot->bits, slot->layout);
+        if (pattern.lo == Option_None)
+            return MATCH_PATTERN(MATCH_PAT_VARIANT, slot->bits, slot->layout | ((int64_t)1 << 25));
+        return pattern;
+    }
+    return MATCH_PATTERN(MATCH_PAT_VARIANT, (uint32_t)pattern.lo, slot->layout);
+}
+
+// Layout of a generated Result/Option/tag_union type. These are integer
+// constant expressions, so they work in _Static_assert and array sizes:
+//   _Static_assert(match_payload_offset(Result_int) == 8, "classic layout");
+#define match_tag_offset(type) offsetof(type, tag)
+#define match_tag_width(type) sizeof(((type*)0)->tag)
+#define match_payload_offset(type) offsetof(type, _payload)
 
 // ============================================================================
 // Pattern Evaluation Engine
 // ============================================================================
 
-// Thread-local storage for extracted variant values
-static __thread void* __variant_extracted_value = ((void*)0);
-
-// Thread-local storage for type information
-static __thread void* __current_subject_ptr = ((void*)0);
-static __thread int __current_subject_type = 0;
-
-// Remove the complex type tracking for now - it's causing compilation issues
-// We'll implement a different approach that's more practical
-
 // Type identification constants
 #define TYPE_UNKNOWN 0
 #define TYPE_OPTION_INT 1
@@ -365,55 +883,178 @@ static __thread int __current_subject_type = 0;
 #define TYPE_RESULT_VOID_PTR 15
 #define TYPE_RESULT_INT_PTR 16
 
-static inline int evaluate_pattern(intptr_t actual, void* pattern) {
-    if (IS_WILDCARD(pattern)) return 1;
-    
-    uintptr_t type = GET_PATTERN_TYPE(pattern);
-    if (type == 0) return actual == (intptr_t)pattern; // Literal match
-    
-    switch (type) {
-        case 1: return actual > GET_PATTERN_VALUE(pattern);   // gt
-        case 2: return actual >= GET_PATTERN_VALUE(pattern);  // ge
-        case 3: return actual < GET_PATTERN_VALUE(pattern);   // lt
-        case 4: return actual <= GET_PATTERN_VALUE(pattern);  // le
-        case 5: return actual != GET_PATTERN_VALUE(pattern);  // ne
-        case 6: { // range (exclusive)
-            intptr_t low = GET_RANGE_LOW(pattern);
-            intptr_t high = GET_RANGE_HIGH(pattern);
-            return actual > low && actual < high;
-        }
-        case 7: { // between (inclusive)
-            intptr_t low = GET_RANGE_LOW(pattern);
-            intptr_t high = GET_RANGE_HIGH(pattern);
-            return actual >= low && actual <= high;
-        }
-        case 8: { // variant destructuring
-            // For variant patterns, 'actual' should point to a tagged union struct
-            // We expect the struct to have .tag as the first field
-            uint32_t expected_tag = GET_VARIANT_TAG(pattern);
-            
-            // Extract tag from the union (assuming first field is the tag)
-            uint32_t union_tag = *((uint32_t*)actual);
-            
-            if (union_tag == expected_tag) {
-                // Find the union field - it typically starts after tag with possible padding
-                // Use 8 bytes as default offset for most modern systems (accounts for padding)
-                // Users can override by defining VARIANT_UNION_OFFSET
-                #ifndef VARIANT_UNION_OFFSET
-                #define VARIANT_UNION_OFFSET 8
-                #endif
-                
-                char* struct_ptr = (char*)actual;
-                __variant_extracted_value = (void*)(struct_ptr + VARIANT_UNION_OFFSET);
-                return 1;
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Membership in an any_of() set of n values (padded to a whole vector)
+MATCH_INLINE int match_set32_contains(int64_t x, const int32_t *set, size_t n) {
+    if (x != (int32_t)x) return 0;
+#if defined(__AVX2__)
+    __m256i needle = _mm256_set1_epi32((int32_t)x);
+    __m256i hit = _mm256_setzero_si256();
+    for (size_t i = 0; i < n; i += 8) {
+        hit = _mm256_or_si256(hit, _mm256_cmpeq_epi32(needle, _mm256_loadu_si256((const __m256i*)(set + i))));
+    }
+    return !_mm256_testz_si256(hit, hit);
+#elif defined(__SSE2__)
+    __m128i needle = _mm_set1_epi32((int32_t)x);
+    __m128i hit = _mm_setzero_si128();
+    for (size_t i = 0; i < n; i += 4) {
+        hit = _mm_or_si128(hit, _mm_cmpeq_epi32(needle, _mm_loadu_si128((const __m128i*)(set + i))));
+    }
+    return _mm_movemask_epi8(hit) != 0;
+#else
+    int hit = 0;
+    for (size_t i = 0; i < n; i++) hit |= (int32_t)x == set[i];
+    return hit;
+#endif
+}
+
+MATCH_INLINE int match_set_contains(int64_t x, const int64_t *set, size_t n) {
+#if defined(__AVX2__)
+    __m256i needle = _mm256_set1_epi64x(x);
+    __m256i hit = _mm256_setzero_si256();
+    for (size_t i = 0; i < n; i += 4) {
+        hit = _mm256_or_si256(hit, _mm256_cmpeq_epi64(needle, _mm256_loadu_si256((const __m256i*)(set + i))));
+    }
+    return !_mm256_testz_si256(hit, hit);
+#elif defined(__SSE2__)
+    // SSE2 has no 64-bit compare: both 32-bit halves must be equal
+    __m128i needle = _mm_set1_epi64x(x);
+    __m128i hit = _mm_setzero_si128();
+    for (size_t i = 0; i < n; i += 2) {
+        __m128i eq = _mm_cmpeq_epi32(needle, _mm_loadu_si128((const __m128i*)(set + i)));
+        hit = _mm_or_si128(hit, _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1))));
+    }
+    return _mm_movemask_epi8(hit) != 0;
+#else
+    int hit = 0;
+    for (size_t i = 0; i < n; i++) hit |= x == set[i];
+    return hit;
+#endif
+}
+
+// Floating-point subjects. Integer patterns are widened to double so that
+// when(gt(10)) still works on a double; the comparisons are IEEE ordered, so
+// NaN only ever satisfies __, fne() and fnan.
+MATCH_INLINE int evaluate_float_pattern(double actual, MatchPattern pattern) {
+    switch (pattern.kind) {
+        case MATCH_PAT_ANY: return 1;
+        case MATCH_PAT_EQ: return actual == (double)pattern.lo;
+        case MATCH_PAT_GT: return actual > (double)pattern.lo;
+        case MATCH_PAT_GE: return actual >= (double)pattern.lo;
+        case MATCH_PAT_LT: return actual < (double)pattern.lo;
+        case MATCH_PAT_LE: return actual <= (double)pattern.lo;
+        case MATCH_PAT_NE: return actual != (double)pattern.lo;
+        case MATCH_PAT_RANGE: return actual > (double)pattern.lo && actual < (double)pattern.hi;
+        case MATCH_PAT_BETWEEN: return actual >= (double)pattern.lo && actual <= (double)pattern.hi;
+        case MATCH_PAT_URANGE:
+            return actual > (double)(uint64_t)pattern.lo && actual < (double)(uint64_t)pattern.hi;
+        case MATCH_PAT_UBETWEEN:
+            return actual >= (double)(uint64_t)pattern.lo && actual <= (double)(uint64_t)pattern.hi;
+        case MATCH_PAT_VARIANT: return 0;
+        case MATCH_PAT_FEQ: return actual == pattern.flo;
+        case MATCH_PAT_FNE: return actual != pattern.flo;
+        case MATCH_PAT_FGT: return actual > pattern.flo;
+        case MATCH_PAT_FGE: return actual >= pattern.flo;
+        case MATCH_PAT_FLT: return actual < pattern.flo;
+        case MATCH_PAT_FLE: return actual <= pattern.flo;
+        case MATCH_PAT_FRANGE: return actual > pattern.flo && actual < pattern.fhi;
+        case MATCH_PAT_FBETWEEN: return actual >= pattern.flo && actual <= pattern.fhi;
+        case MATCH_PAT_FNAN: return actual != actual;
+        case MATCH_PAT_STR: return 0;
+        case MATCH_PAT_MASK:
+            return actual >= 0 && actual < 64 && actual == (double)(int)actual &&
+                   ((uint64_t)pattern.lo >> (int)actual) & 1;
+        case MATCH_PAT_SET32:
+            for (int64_t i = 0; i < pattern.hi; i++) {
+                if (actual == (double)((const int32_t*)(intptr_t)pattern.lo)[i]) return 1;
+            }
+            return 0;
+        case MATCH_PAT_SET:
+            for (int64_t i = 0; i < pattern.hi; i++) {
+                if (actual == (double)((const int64_t*)(intptr_t)pattern.lo)[i]) return 1;
             }
             return 0;
+    }
+    return 0;
+}
+
+// String subjects. The literal's length and bytes are constants at the use
+// site, so an arm is a length compare first, then a single 8-byte word
+// compare (or one inlined compare of up to 8 bytes for short literals), and
+// only literals longer than 8 bytes fall back to memcmp for the tail. Arms
+// whose length differs are rejected by the first compare and never touch
+// the string. strlen is pure, so for a char * subject it runs once per match
+// however many str() arms there are.
+//
+// A char * subject against a literal shorter than 8 bytes skips strlen and
+// walks the literal instead: the loop unrolls into byte compares against
+// constants (str("") is a single load of the first byte), and a shorter
+// string fails at its terminator, so nothing past it is read. Matches with a
+// few short arms then cost what the equivalent strcmp calls fold to.
+MATCH_INLINE int evaluate_str_pattern(MatchStr text, MatchPattern pattern) {
+    const char *lit = (const char*)(intptr_t)pattern.lo;
+    size_t len = (size_t)pattern.hi;
+    if (text.ptr == ((void*)0)) return 0;
+    if (text.len == MATCH_STR_CSTR && len < 8) {
+        for (size_t i = 0; i < len; i++) {
+            if (lit[i] == 0 || text.ptr[i] != lit[i]) return 0;
+        }
+        return text.ptr[len] == 0;
+    }
+    if ((text.len == MATCH_STR_CSTR ? __builtin_strlen(text.ptr) : text.len) != len) return 0;
+    if (len < 8) return __builtin_memcmp(text.ptr, lit, len) == 0;
+    uint64_t word, lit_word;
+    __builtin_memcpy(&word, text.ptr, 8);
+    __builtin_memcpy(&lit_word, lit, 8);
+    return word == lit_word && __builtin_memcmp(text.ptr + 8, lit + 8, len - 8) == 0;
+}
+
+MATCH_INLINE int evaluate_pattern(intptr_t actual, MatchPattern pattern) {
+    if (MATCH_PAT_IS_FLOAT(pattern.kind)) return evaluate_float_pattern((double)actual, pattern);
+    switch (pattern.kind) {
+        case MATCH_PAT_ANY: return 1;
+        case MATCH_PAT_EQ: return actual == pattern.lo;
+        case MATCH_PAT_GT: return actual > pattern.lo;
+        case MATCH_PAT_GE: return actual >= pattern.lo;
+        case MATCH_PAT_LT: return actual < pattern.lo;
+        case MATCH_PAT_LE: return actual <= pattern.lo;
+        case MATCH_PAT_NE: return actual != pattern.lo;
+        // With constant bounds the compiler folds each pair of compares into a
+        // single unsigned subtract-and-compare
+        case MATCH_PAT_RANGE: return actual > pattern.lo && actual < pattern.hi;
+        case MATCH_PAT_BETWEEN: return actual >= pattern.lo && actual <= pattern.hi;
+        case MATCH_PAT_URANGE:
+            return (uint64_t)actual > (uint64_t)pattern.lo && (uint64_t)actual < (uint64_t)pattern.hi;
+        case MATCH_PAT_UBETWEEN:
+            return (uint64_t)actual >= (uint64_t)pattern.lo && (uint64_t)actual <= (uint64_t)pattern.hi;
+        case MATCH_PAT_MASK: return (uint64_t)actual < 64 && (((uint64_t)pattern.lo >> actual) & 1);
+        case MATCH_PAT_SET32:
+            return match_set32_contains((int64_t)actual, (const int32_t*)(intptr_t)pattern.lo, (size_t)pattern.hi);
+        case MATCH_PAT_SET:
+            return match_set_contains((int64_t)actual, (const int64_t*)(intptr_t)pattern.lo, (size_t)pattern.hi);
+        case MATCH_PAT_VARIANT: {
+            // 'actual' points to a tagged struct; the layout word says where its
+            // tag lives and how wide it is. Both are constants at the match
+            // site, so this folds to a single load and compare of the right
+            // width (memcpy keeps tags in packed structs legal to read). The
+            // payload is reached through the match site's own subject local,
+            // never through shared state.
+            uint64_t tag = match_load_tag((const char*)actual + MATCH_TAG_OFFSET(pattern.hi),
+                                          MATCH_TAG_WIDTH(pattern.hi));
+            if (MATCH_TAG_NICHE(pattern.hi)) {
+                return (tag == (uint64_t)pattern.lo) == MATCH_TAG_WANTS_NONE(pattern.hi);
+            }
+            return tag == (uint32_t)pattern.lo;
         }
+        default: return 0;
     }
     return 0;
 }
 
-static inline int evaluate_pattern_enhanced(void* subject, intptr_t actual, void* pattern) {
+MATCH_INLINE int evaluate_pattern_enhanced(void* subject, intptr_t actual, MatchPattern pattern) {
     // First check if this could be a tagged union auto-variant case
     // Only applies to the first argument when it's a pointer to a struct
     if (subject != ((void*)0) && (uintptr_t)subject > 0x1000) {  // Basic pointer sanity check
@@ -425,16 +1066,14 @@ static inline int evaluate_pattern_enhanced(void* subject, intptr_t actual, void
             actual_struct = (void*)actual;
         }
         
-        // Check if pattern is a small integer (likely enum value) and not a special pattern
-        uintptr_t pattern_val = (uintptr_t)pattern;
-        if (pattern_val <= 0xFFFF && (pattern_val >> 60) == 0) {  // Not a special pattern
+        // Check if pattern is a small integer literal (likely enum value)
+        if (pattern.kind == MATCH_PAT_EQ && (uintptr_t)pattern.lo <= 0xFFFF) {
             // Check if subject looks like a tagged union
             uint32_t potential_tag = *(uint32_t*)actual_struct;
             if (potential_tag > 0 && potential_tag <= 0xFFFF) {  // Reasonable tag range
-                if (potential_tag == (uint32_t)pattern_val) {
+                if (potential_tag == (uint32_t)pattern.lo) {
                     // Auto-convert to variant match!
-                    void* variant_pattern = (void*)(0x8000000000000000ULL | (((uint64_t)potential_tag << 16) | 1));
-                    return evaluate_pattern((intptr_t)actual_struct, variant_pattern);
+                    return evaluate_pattern((intptr_t)actual_struct, variant(potential_tag));
                 }
             }
         }
@@ -444,6 +1083,65 @@ static inline int evaluate_pattern_enhanced(void* subject, intptr_t actual, void
     return evaluate_pattern(actual, pattern);
 }
 
+// ============================================================================
+// Dispatch Modes
+// ============================================================================
+
+// Auto mode (default) keeps the convenience of when(Option_Some) on &option:
+// small literal patterns are speculatively compared against the tag of
+// anything that looks like a pointer. Strict mode never dereferences the
+// subject for literals; only variant(tag) reads a tag, and it does so directly.
+//
+// Select strict mode per site with match_strict()/let_strict(), or for a whole
+// translation unit by defining MATCH_STRICT before including this header
+// (match_auto()/let_auto() then opt individual sites back in).
+#define MATCH_MODE_AUTO 0
+#define MATCH_MODE_STRICT 1
+
+#ifdef MATCH_STRICT
+#define MATCH_DEFAULT_MODE MATCH_MODE_STRICT
+#else
+#define MATCH_DEFAULT_MODE MATCH_MODE_AUTO
+#endif
+
+MATCH_INLINE int evaluate_pattern_mode(int strict, void* subject, intptr_t actual, MatchPattern pattern) {
+    return strict ? evaluate_pattern(actual, pattern)
+                  : evaluate_pattern_enhanced(subject, actual, pattern);
+}
+
+// Every match()/let() arm goes through here. Floating-point subjects are
+// compared by value in their own type, so a double is never truncated or
+// bit-cast to an integer; str() patterns compare the subject's text; everything
+// else keeps the integer/pointer path.
+MATCH_INLINE int evaluate_pattern_typed(int strict, void* subject, intptr_t actual,
+                                        int is_float, double factual, MatchStr text,
+                                        MatchPattern pattern) {
+    if (pattern.kind == MATCH_PAT_STR) return evaluate_str_pattern(text, pattern);
+    return is_float ? evaluate_float_pattern(factual, pattern)
+                    : evaluate_pattern_mode(strict, subject, actual, pattern);
+}
+
+#define MATCH_IS_FLOAT(v) _Generic((v), float: 1, double: 1, long double: 1, default: 0)
+#define MATCH_AS_DOUBLE(v) \
+    ((double)_Generic((v), float: (v), double: (v), long double: (v), default: 0))
+// Floating-point subjects take the float path and never use this value; 0
+// keeps NaN and out-of-range doubles from being converted (undefined)
+#define MATCH_AS_INTPTR(v) \
+    ((intptr_t)_Generic((v), MatchStr: 0, float: 0, double: 0, long double: 0, default: (v)))
+#define MATCH_AS_STR(v) \
+    _Generic((v), \
+        MatchStr: _Generic((v), MatchStr: (v), default: str_view(0, 0)), \
+        char *: str_view(_Generic((v), char *: (v), default: 0), MATCH_STR_CSTR), \
+        const char *: str_view(_Generic((v), const char *: (v), default: 0), MATCH_STR_CSTR), \
+        default: str_view(0, 0))
+// The arm's pattern is evaluated with the subject in scope as __match_subject,
+// which is how variant() learns the subject's tag layout
+#define MATCH_TEST(v, x) \
+    ({ __typeof__(v##_val) __match_subject __attribute__((unused)) = v##_val; \
+       evaluate_pattern_typed(__match_strict, v##_orig, (intptr_t)v, MATCH_IS_FLOAT(v##_val), \
+                              MATCH_AS_DOUBLE(v##_val), MATCH_AS_STR(v##_val), \
+                              MATCH_AUTO_LAYOUT(__match_strict, __match_subject, _auto_pattern(x))); })
+
 // ============================================================================
 // Union Value Access - Direct Field Access (Recommended)
 // ============================================================================
@@ -461,174 +1159,454 @@ static inline int evaluate_pattern_enhanced(void* subject, intptr_t actual, void
 //       when(Ok) { int x = my_result.value; }
 //       when(Err) { char* err = my_result.error; }
 //   }
+//
+// it(type) reads the payload of the first subject of the enclosing
+// match()/let() for the generated Result/Option/tag_union types: the offset
+// comes from offsetof on the subject's actual type, so compact and packed
+// layouts are read correctly, and the load goes through the same pointer the
+// tag was just read from, so no second trip through the original struct.
+// The payload is copied out with memcpy (one plain load once inlined) since
+// in a tag_union_packed array it is usually not aligned for its type; the
+// result is a value, not an lvalue:
+//
+//   double half = let(&res) in(is(variant(Result_Ok)) ? it(double) / 2 : 0.0);
+#define it(type) ({ \
+    type __it_value; \
+    __builtin_memcpy(&__it_value, (char*)__v1_val + offsetof(__typeof__(*__v1_val), _payload), sizeof(type)); \
+    __it_value; })
+
+// variant_value(type) is the older name for it(type)
+#define variant_value(type) it(type)
+
+// when_bind(pattern, type, name) is when(pattern) that also hands the arm a
+// typed local holding the payload, computed once:
+//
+//   match(&res) {
+//       when_bind(variant(Result_Ok), double, value) { use(value); }
+//       when_bind(variant(Result_Err), char*, msg) { log(msg); }
+//   }
+#define when_bind(pattern, type, name) \
+    WHEN_1(pattern) \
+        for (int __bind_once = 1; __bind_once; __bind_once = 0) \
+            for (type name = it(type); __bind_once; __bind_once = 0)
 
 
 // ============================================================================
 // Automatic Pattern Conversion
 // ============================================================================
 
-// Automatically converts literals to patterns using _Generic
+// Automatically converts literals to patterns using _Generic. Typed patterns
+// pass through unchanged, float/double literals become feq(), and anything
+// else (integers, enums, chars, pointers) becomes an equality pattern. The
+// inner _Generic keeps the unselected branches well-formed when x is already
+// a MatchPattern.
 #define _auto_pattern(x) \
     _Generic((x), \
-        void*: (x), \
-        int: ((void*)(intptr_t)(x)), \
-        long: ((void*)(intptr_t)(x)), \
-        short: ((void*)(intptr_t)(x)), \
-        char: ((void*)(intptr_t)(x)), \
-        unsigned int: ((void*)(intptr_t)(x)), \
-        unsigned long: ((void*)(intptr_t)(x)), \
-        unsigned short: ((void*)(intptr_t)(x)), \
-        unsigned char: ((void*)(intptr_t)(x)), \
-        default: (x))
+        MatchPattern: (x), \
+        float: MATCH_FPATTERN(MATCH_PAT_FEQ, _Generic((x), float: (x), double: (x), default: 0), 0), \
+        double: MATCH_FPATTERN(MATCH_PAT_FEQ, _Generic((x), float: (x), double: (x), default: 0), 0), \
+        default: MATCH_PATTERN(MATCH_PAT_EQ, _Generic((x), MatchPattern: 0, default: (x)), 0))
+
+// ============================================================================
+// Arm-Hit Profiling (MATCH_PROFILE)
+// ============================================================================
+
+// Define MATCH_PROFILE before including this header to count how often each
+// arm is taken. Every when()/otherwise/when_case()/is() that can fire gets a
+// static descriptor (file, function, site line, arm line) in the
+// "match_profile" section, so arms that never fire are listed too. A hit
+// bumps the calling thread's shard of that arm's counter; shards sit on
+// separate cache lines and threads are dealt out to them round-robin. Each
+// match()/let() also gets a "site" descriptor counting how often it is
+// entered, which covers runs that fall through every arm, such as the final
+// else of an is() ladder.
+//
+// At exit the counts are written to $MATCH_PROFILE_OUT as tab-separated
+// records (see match_profile_dump), or as a readable report on stderr when
+// the variable is unset. match_profile_report()/match_profile_dump() print
+// them on demand and match_profile_reset() starts over.
+//
+// Without MATCH_PROFILE the hooks below expand to nothing, and when()/is()
+// expand to exactly the same tokens as they would without them.
+#ifdef MATCH_PROFILE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef MATCH_PROFILE_SHARDS
+#define MATCH_PROFILE_SHARDS 8
+#endif
+
+typedef struct __attribute__((aligned(64))) {
+    uint64_t count;
+} MatchProfileShard;
+
+typedef struct __attribute__((aligned(64))) {
+    const char *file;
+    const char *func;
+    const char *kind;       // "site", "when", "otherwise", "case" or "is"
+    int site_line;          // line of the enclosing match()/let()
+    int arm_line;
+    int order;              // line of the arm (of the site for its own record)
+    MatchProfileShard hits[MATCH_PROFILE_SHARDS];
+} MatchProfileArm;
+
+// Bounds of the descriptor section, provided by the linker
+extern MatchProfileArm __start_match_profile[] __attribute__((weak));
+extern MatchProfileArm __stop_match_profile[] __attribute__((weak));
+
+// One definition each for the whole program, whatever the number of
+// translation units including this header
+__attribute__((weak)) __thread unsigned match_profile_thread_shard;  // shard + 1, 0 until assigned
+__attribute__((weak)) unsigned match_profile_next_shard;
+__attribute__((weak)) int match_profile_exit_registered;
+
+MATCH_INLINE int match_profile_hit(MatchProfileArm *arm) {
+    unsigned shard = match_profile_thread_shard;
+    if (__builtin_expect(shard == 0, 0)) {
+        shard = __atomic_fetch_add(&match_profile_next_shard, 1, __ATOMIC_RELAXED) % MATCH_PROFILE_SHARDS + 1;
+        match_profile_thread_shard = shard;
+    }
+    __atomic_fetch_add(&arm->hits[shard - 1].count, 1, __ATOMIC_RELAXED);
+    return 1;
+}
+
+static inline uint64_t match_profile_count(const MatchProfileArm *arm) {
+    uint64_t total = 0;
+    for (int s = 0; s < MATCH_PROFILE_SHARDS; s++)
+        total += __atomic_load_n(&arm->hits[s].count, __ATOMIC_RELAXED);
+    return total;
+}
+
+static inline int match_profile_is_site(const MatchProfileArm *arm) {
+    return strcmp(arm->kind, "site") == 0;
+}
+
+static inline int match_profile_same_site(const MatchProfileArm *a, const MatchProfileArm *b) {
+    return a->site_line == b->site_line && strcmp(a->file, b->file) == 0 && strcmp(a->func, b->func) == 0;
+}
+
+// Site order: file, site line, function; the site's own record, then its
+// arms by line. Arms that share a line keep their section order: match_pgo
+// gives such lines no hint, and the reach left for later lines is the same
+// either way. Descriptors take no __COUNTER__ value, which stays free for the
+// layout registry (see MATCH_SLOTS).
+static int match_profile_compare(const void *pa, const void *pb) {
+    const MatchProfileArm *a = *(const MatchProfileArm *const *)pa;
+    const MatchProfileArm *b = *(const MatchProfileArm *const *)pb;
+    int c = strcmp(a->file, b->file);
+    if (c == 0) c = (a->site_line > b->site_line) - (a->site_line < b->site_line);
+    if (c == 0) c = strcmp(a->func, b->func);
+    if (c == 0) c = match_profile_is_site(b) - match_profile_is_site(a);
+    if (c == 0) c = (a->order > b->order) - (a->order < b->order);
+    if (c == 0) c = (a > b) - (a < b);
+    return c;
+}
+
+// All descriptors sorted by site, or NULL when there are none
+static inline const MatchProfileArm **match_profile_arms(size_t *n) {
+    *n = (size_t)(__stop_match_profile - __start_match_profile);
+    if (*n == 0) return NULL;
+    const MatchProfileArm **arms = malloc(*n * sizeof *arms);
+    if (!arms) { *n = 0; return NULL; }
+    for (size_t i = 0; i < *n; i++) arms[i] = &__start_match_profile[i];
+    qsort(arms, *n, sizeof *arms, match_profile_compare);
+    return arms;
+}
+
+// One record per arm, tab-separated:
+//   file  function  site_line  arm_index  kind  arm_line  hits
+// arm_index counts the arms of a site from 0 in source order. The site's own
+// record comes first, with arm_index -1 and the number of times it was entered.
+static inline void match_profile_dump(FILE *out) {
+    size_t n;
+    const MatchProfileArm **arms = match_profile_arms(&n);
+    int index = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (i == 0 || !match_profile_same_site(arms[i - 1], arms[i])) index = 0;
+        fprintf(out, "%s\t%s\t%d\t%d\t%s\t%d\t%llu\n", arms[i]->file, arms[i]->func, arms[i]->site_line,
+                match_profile_is_site(arms[i]) ? -1 : index++, arms[i]->kind, arms[i]->arm_line,
+                (unsigned long long)match_profile_count(arms[i]));
+    }
+    free(arms);
+}
+
+// Per site: times entered, then each arm's hits and share of the entries
+static inline void match_profile_report(FILE *out) {
+    size_t n;
+    const MatchProfileArm **arms = match_profile_arms(&n);
+    size_t sites = 0;
+    for (size_t i = 0; i < n; i++) sites += match_profile_is_site(arms[i]);
+    fprintf(out, "=== match profile: %zu arms ===\n", n - sites);
+    for (size_t i = 0; i < n; ) {
+        size_t first = match_profile_is_site(arms[i]) ? i + 1 : i, end = first;
+        uint64_t taken = 0;
+        while (end < n && match_profile_same_site(arms[i], arms[end])) taken += match_profile_count(arms[end++]);
+        uint64_t total = first > i ? match_profile_count(arms[i]) : taken;
+        fprintf(out, "%s:%d %s() - %llu hits\n", arms[i]->file, arms[i]->site_line, arms[i]->func,
+                (unsigned long long)total);
+        for (size_t k = first; k < end; k++) {
+            uint64_t hits = match_profile_count(arms[k]);
+            fprintf(out, "  arm %zu  %-9s line %-5d %12llu  %5.1f%%\n", k - first, arms[k]->kind, arms[k]->arm_line,
+                    (unsigned long long)hits, total ? 100.0 * (double)hits / (double)total : 0.0);
+        }
+        if (total > taken)
+            fprintf(out, "  no arm                      %12llu  %5.1f%%\n", (unsigned long long)(total - taken),
+                    100.0 * (double)(total - taken) / (double)total);
+        i = end;
+    }
+    free(arms);
+}
+
+static inline void match_profile_reset(void) {
+    for (MatchProfileArm *arm = __start_match_profile; arm < __stop_match_profile; arm++)
+        for (int s = 0; s < MATCH_PROFILE_SHARDS; s++)
+            __atomic_store_n(&arm->hits[s].count, 0, __ATOMIC_RELAXED);
+}
+
+static void match_profile_at_exit(void) {
+    const char *path = getenv("MATCH_PROFILE_OUT");
+    FILE *out = path && *path ? fopen(path, "w") : NULL;
+    if (out) {
+        match_profile_dump(out);
+        fclose(out);
+    } else {
+        match_profile_report(stderr);
+    }
+}
+
+// Every translation unit has this constructor; the first one to run wins
+__attribute__((constructor)) static void match_profile_register_exit(void) {
+    if (!__atomic_exchange_n(&match_profile_exit_registered, 1, __ATOMIC_ACQ_REL))
+        atexit(match_profile_at_exit);
+}
+
+// match()/let() record their line in the type of __match_site, where an arm's
+// static initializer can read it as a constant, and count their own entries
+#define MATCH_PROFILE_SITE \
+    , (*__match_site)[__LINE__] __attribute__((unused)) = 0, \
+    __match_entered __attribute__((unused)) = ({ \
+        static MatchProfileArm __match_arm __attribute__((section("match_profile"), used)) = { \
+            .file = __FILE__, .func = __func__, .kind = "site", \
+            .site_line = __LINE__, .arm_line = __LINE__, .order = __LINE__ }; \
+        match_profile_hit(&__match_arm); })
+#define MATCH_PROFILE_SITE_LINE ((int)(sizeof(*__match_site) / sizeof(**__match_site)))
+
+// taken is the arm's condition; the descriptor is only touched when it holds
+#define MATCH_ARM_HIT(arm_kind, taken) \
+    ((taken) && ({ \
+        static MatchProfileArm __match_arm __attribute__((section("match_profile"), used)) = { \
+            .file = __FILE__, .func = __func__, .kind = #arm_kind, \
+            .site_line = MATCH_PROFILE_SITE_LINE, .arm_line = __LINE__, .order = __LINE__ }; \
+        match_profile_hit(&__match_arm); }))
+
+#else
+
+#define MATCH_PROFILE_SITE
+#define MATCH_ARM_HIT(arm_kind, taken) taken
+
+#endif
+
+// ============================================================================
+// Profile-Guided Arm Hints (MATCH_HINTS)
+// ============================================================================
+
+// tools/match_pgo turns a MATCH_PROFILE_OUT dump into a header of per-line
+// branch probabilities for one source file:
+//
+//   #define MATCH_HINTS
+//   #define MATCH_HINT_L42 ~, 913    // when() on line 42 holds 91.3% of the
+//                                    // times it is tested
+//
+// Include that header before match.h and every when()/is() on a listed line
+// tests its patterns through __builtin_expect_with_probability, so the
+// compiler lays out the hot arm as the fall-through path. Lines without a
+// hint expand as usual. Hints never change which arm is taken, and arm order
+// stays the programmer's: the tool only suggests reordering, since moving an
+// arm is only safe when the arms are disjoint.
+//
+// A hint belongs to a line number, not a file: include the header in the
+// profiled source only. A header that matches on a hinted line number picks
+// up the same probability, which can only cost speed.
+#ifdef MATCH_HINTS
+
+// MATCH_HINT_L<line> expands to "~, permille" for hinted lines; otherwise
+// the probe sees the name itself, one argument, and picks the -1 fallback
+#define MATCH_HINT_FOR(line) MATCH_HINT_FOR_(line)
+#define MATCH_HINT_FOR_(line) MATCH_HINT_PICK(MATCH_HINT_L##line, -1, ~)
+#define MATCH_HINT_PICK(...) MATCH_HINT_SECOND(__VA_ARGS__)
+#define MATCH_HINT_SECOND(a, b, ...) b
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_expect_with_probability)
+#define MATCH_EXPECT_PERMILLE(test, p) __builtin_expect_with_probability(!!(test), 1, (p) / 1000.0)
+#endif
+#endif
+#ifndef MATCH_EXPECT_PERMILLE
+#define MATCH_EXPECT_PERMILLE(test, p) __builtin_expect(!!(test), (p) >= 500)
+#endif
+
+#define MATCH_ARM_HINT(test) MATCH_ARM_HINT_P(MATCH_HINT_FOR(__LINE__), test)
+#define MATCH_ARM_HINT_P(p, test) \
+    __builtin_choose_expr((p) < 0, (test), MATCH_EXPECT_PERMILLE(test, (p) < 0 ? 0 : (p)))
+
+#else
+
+#define MATCH_ARM_HINT(test) test
+
+#endif
 
 // ============================================================================
 // Statement Form: match() { when() { ... } otherwise { ... } }
 // ============================================================================
 
-#define match(...) MATCH_DISPATCH(COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)
-#define MATCH_DISPATCH(N, ...) MATCH_DISPATCH_(N, __VA_ARGS__)
-#define MATCH_DISPATCH_(N, ...) MATCH_##N(__VA_ARGS__)
+#define match(...) MATCH_DISPATCH(MATCH_DEFAULT_MODE, COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)
+#define match_strict(...) MATCH_DISPATCH(MATCH_MODE_STRICT, COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)
+#define match_auto(...) MATCH_DISPATCH(MATCH_MODE_AUTO, COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)
+#define MATCH_DISPATCH(mode, N, ...) MATCH_DISPATCH_(mode, N, __VA_ARGS__)
+#define MATCH_DISPATCH_(mode, N, ...) MATCH_##N(mode, __VA_ARGS__)
 
 // Match macros for 1-10 arguments
-#define MATCH_1(a1) \
-    for (int __matched = 0; !__matched;) \
-        for (void *__v1 = (void*)(intptr_t)(a1); !__matched;) \
-            for (void *__v1_orig = (void*)(a1); !__matched;)
-
-#define MATCH_2(a1, a2) \
-    for (int __matched = 0; !__matched;) \
-        for (void *__v1 = (void*)(intptr_t)(a1); !__matched;) \
-            for (void *__v1_orig = (void*)(a1); !__matched;) \
-                for (void *__v2 = (void*)(intptr_t)(a2); !__matched;) \
-                    for (void *__v2_orig = (void*)(a2); !__matched;)
-
-#define MATCH_3(a1, a2, a3) \
-    for (int __matched = 0; !__matched;) \
-        for (void *__v1 = (void*)(intptr_t)(a1); !__matched;) \
-            for (void *__v1_orig = (void*)(a1); !__matched;) \
-                for (void *__v2 = (void*)(intptr_t)(a2); !__matched;) \
-                    for (void *__v2_orig = (void*)(a2); !__matched;) \
-                        for (void *__v3 = (void*)(intptr_t)(a3); !__matched;) \
-                            for (void *__v3_orig = (void*)(a3); !__matched;)
-
-#define MATCH_4(a1, a2, a3, a4) \
-    for (int __matched = 0; !__matched;) \
-        for (void *__v1 = (void*)(intptr_t)(a1); !__matched;) \
-            for (void *__v1_orig = (void*)(a1); !__matched;) \
-                for (void *__v2 = (void*)(intptr_t)(a2); !__matched;) \
-                    for (void *__v2_orig = (void*)(a2); !__matched;) \
-                        for (void *__v3 = (void*)(intptr_t)(a3); !__matched;) \
-                            for (void *__v3_orig = (void*)(a3); !__matched;) \
-                                for (void *__v4 = (void*)(intptr_t)(a4); !__matched;) \
-                                    for (void *__v4_orig = (void*)(a4); !__matched;)
-
-#define MATCH_5(a1, a2, a3, a4, a5) \
-    for (int __matched = 0; !__matched;) \
-        for (void *__v1 = (void*)(intptr_t)(a1); !__matched;) \
-            for (void *__v1_orig = (void*)(a1); !__matched;) \
-                for (void *__v2 = (void*)(intptr_t)(a2); !__matched;) \
-                    for (void *__v2_orig = (void*)(a2); !__matched;) \
-                        for (void *__v3 = (void*)(intptr_t)(a3); !__matched;) \
-                            for (void *__v3_orig = (void*)(a3); !__matched;) \
-                                for (void *__v4 = (void*)(intptr_t)(a4); !__matched;) \
-                                    for (void *__v4_orig = (void*)(a4); !__matched;) \
-                                        for (void *__v5 = (void*)(intptr_t)(a5); !__matched;) \
-                                            for (void *__v5_orig = (void*)(a5); !__matched;)
-
-#define MATCH_6(a1, a2, a3, a4, a5, a6) \
-    for (int __matched = 0; !__matched;) \
-        for (void *__v1 = (void*)(intptr_t)(a1); !__matched;) \
-            for (void *__v1_orig = (void*)(a1); !__matched;) \
-                for (void *__v2 = (void*)(intptr_t)(a2); !__matched;) \
-                    for (void *__v2_orig = (void*)(a2); !__matched;) \
-                        for (void *__v3 = (void*)(intptr_t)(a3); !__matched;) \
-                            for (void *__v3_orig = (void*)(a3); !__matched;) \
-                                for (void *__v4 = (void*)(intptr_t)(a4); !__matched;) \
-                                    for (void *__v4_orig = (void*)(a4); !__matched;) \
-                                        for (void *__v5 = (void*)(intptr_t)(a5); !__matched;) \
-                                            for (void *__v5_orig = (void*)(a5); !__matched;) \
-                                                for (void *__v6 = (void*)(intptr_t)(a6); !__matched;) \
-                                                    for (void *__v6_orig = (void*)(a6); !__matched;)
-
-#define MATCH_7(a1, a2, a3, a4, a5, a6, a7) \
-    for (int __matched = 0; !__matched;) \
-        for (void *__v1 = (void*)(intptr_t)(a1); !__matched;) \
-            for (void *__v1_orig = (void*)(a1); !__matched;) \
-                for (void *__v2 = (void*)(intptr_t)(a2); !__matched;) \
-                    for (void *__v2_orig = (void*)(a2); !__matched;) \
-                        for (void *__v3 = (void*)(intptr_t)(a3); !__matched;) \
-                            for (void *__v3_orig = (void*)(a3); !__matched;) \
-                                for (void *__v4 = (void*)(intptr_t)(a4); !__matched;) \
-                                    for (void *__v4_orig = (void*)(a4); !__matched;) \
-                                        for (void *__v5 = (void*)(intptr_t)(a5); !__matched;) \
-                                            for (void *__v5_orig = (void*)(a5); !__matched;) \
-                                                for (void *__v6 = (void*)(intptr_t)(a6); !__matched;) \
-                                                    for (void *__v6_orig = (void*)(a6); !__matched;) \
-                                                        for (void *__v7 = (void*)(intptr_t)(a7); !__matched;) \
-                                                            for (void *__v7_orig = (void*)(a7); !__matched;)
-
-#define MATCH_8(a1, a2, a3, a4, a5, a6, a7, a8) \
-    for (int __matched = 0; !__matched;) \
-        for (void *__v1 = (void*)(intptr_t)(a1); !__matched;) \
-            for (void *__v1_orig = (void*)(a1); !__matched;) \
-                for (void *__v2 = (void*)(intptr_t)(a2); !__matched;) \
-                    for (void *__v2_orig = (void*)(a2); !__matched;) \
-                        for (void *__v3 = (void*)(intptr_t)(a3); !__matched;) \
-                            for (void *__v3_orig = (void*)(a3); !__matched;) \
-                                for (void *__v4 = (void*)(intptr_t)(a4); !__matched;) \
-                                    for (void *__v4_orig = (void*)(a4); !__matched;) \
-                                        for (void *__v5 = (void*)(intptr_t)(a5); !__matched;) \
-                                            for (void *__v5_orig = (void*)(a5); !__matched;) \
-                                                for (void *__v6 = (void*)(intptr_t)(a6); !__matched;) \
-                                                    for (void *__v6_orig = (void*)(a6); !__matched;) \
-                                                        for (void *__v7 = (void*)(intptr_t)(a7); !__matched;) \
-                                                            for (void *__v7_orig = (void*)(a7); !__matched;) \
-                                                                for (void *__v8 = (void*)(intptr_t)(a8); !__matched;) \
-                                                                    for (void *__v8_orig = (void*)(a8); !__matched;)
-
-#define MATCH_9(a1, a2, a3, a4, a5, a6, a7, a8, a9) \
-    for (int __matched = 0; !__matched;) \
-        for (void *__v1 = (void*)(intptr_t)(a1); !__matched;) \
-            for (void *__v1_orig = (void*)(a1); !__matched;) \
-                for (void *__v2 = (void*)(intptr_t)(a2); !__matched;) \
-                    for (void *__v2_orig = (void*)(a2); !__matched;) \
-                        for (void *__v3 = (void*)(intptr_t)(a3); !__matched;) \
-                            for (void *__v3_orig = (void*)(a3); !__matched;) \
-                                for (void *__v4 = (void*)(intptr_t)(a4); !__matched;) \
-                                    for (void *__v4_orig = (void*)(a4); !__matched;) \
-                                        for (void *__v5 = (void*)(intptr_t)(a5); !__matched;) \
-                                            for (void *__v5_orig = (void*)(a5); !__matched;) \
-                                                for (void *__v6 = (void*)(intptr_t)(a6); !__matched;) \
-                                                    for (void *__v6_orig = (void*)(a6); !__matched;) \
-                                                        for (void *__v7 = (void*)(intptr_t)(a7); !__matched;) \
-                                                            for (void *__v7_orig = (void*)(a7); !__matched;) \
-                                                                for (void *__v8 = (void*)(intptr_t)(a8); !__matched;) \
-                                                                    for (void *__v8_orig = (void*)(a8); !__matched;) \
-                                                                        for (void *__v9 = (void*)(intptr_t)(a9); !__matched;) \
-                                                                            for (void *__v9_orig = (void*)(a9); !__matched;)
-
-#define MATCH_10(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10) \
-    for (int __matched = 0; !__matched;) \
-        for (void *__v1 = (void*)(intptr_t)(a1); !__matched;) \
-            for (void *__v1_orig = (void*)(a1); !__matched;) \
-                for (void *__v2 = (void*)(intptr_t)(a2); !__matched;) \
-                    for (void *__v2_orig = (void*)(a2); !__matched;) \
-                        for (void *__v3 = (void*)(intptr_t)(a3); !__matched;) \
-                            for (void *__v3_orig = (void*)(a3); !__matched;) \
-                                for (void *__v4 = (void*)(intptr_t)(a4); !__matched;) \
-                                    for (void *__v4_orig = (void*)(a4); !__matched;) \
-                                        for (void *__v5 = (void*)(intptr_t)(a5); !__matched;) \
-                                            for (void *__v5_orig = (void*)(a5); !__matched;) \
-                                                for (void *__v6 = (void*)(intptr_t)(a6); !__matched;) \
-                                                    for (void *__v6_orig = (void*)(a6); !__matched;) \
-                                                        for (void *__v7 = (void*)(intptr_t)(a7); !__matched;) \
-                                                            for (void *__v7_orig = (void*)(a7); !__matched;) \
-                                                                for (void *__v8 = (void*)(intptr_t)(a8); !__matched;) \
-                                                                    for (void *__v8_orig = (void*)(a8); !__matched;) \
-                                                                        for (void *__v9 = (void*)(intptr_t)(a9); !__matched;) \
-                                                                            for (void *__v9_orig = (void*)(a9); !__matched;) \
-                                                                                for (void *__v10 = (void*)(intptr_t)(a10); !__matched;) \
-                                                                                    for (void *__v10_orig = (void*)(a10); !__matched;)
+#define MATCH_1(mode, a1) \
+    for (int __matched = 0, __match_strict = (mode) MATCH_PROFILE_SITE; !__matched; __matched = 1) \
+        for (__auto_type __v1_val = (a1); !__matched; __matched = 1) \
+            for (void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig = __v1; !__matched; __matched = 1)
+
+#define MATCH_2(mode, a1, a2) \
+    for (int __matched = 0, __match_strict = (mode) MATCH_PROFILE_SITE; !__matched; __matched = 1) \
+        for (__auto_type __v1_val = (a1); !__matched; __matched = 1) \
+            for (void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig = __v1; !__matched; __matched = 1) \
+                for (__auto_type __v2_val = (a2); !__matched; __matched = 1) \
+                    for (void *__v2 = (void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig = __v2; !__matched; __matched = 1)
+
+#define MATCH_3(mode, a1, a2, a3) \
+    for (int __matched = 0, __match_strict = (mode) MATCH_PROFILE_SITE; !__matched; __matched = 1) \
+        for (__auto_type __v1_val = (a1); !__matched; __matched = 1) \
+            for (void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig = __v1; !__matched; __matched = 1) \
+                for (__auto_type __v2_val = (a2); !__matched; __matched = 1) \
+                    for (void *__v2 = (void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig = __v2; !__matched; __matched = 1) \
+                        for (__auto_type __v3_val = (a3); !__matched; __matched = 1) \
+                            for (void *__v3 = (void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig = __v3; !__matched; __matched = 1)
+
+#define MATCH_4(mode, a1, a2, a3, a4) \
+    for (int __matched = 0, __match_strict = (mode) MATCH_PROFILE_SITE; !__matched; __matched = 1) \
+        for (__auto_type __v1_val = (a1); !__matched; __matched = 1) \
+            for (void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig = __v1; !__matched; __matched = 1) \
+                for (__auto_type __v2_val = (a2); !__matched; __matched = 1) \
+                    for (void *__v2 = (void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig = __v2; !__matched; __matched = 1) \
+                        for (__auto_type __v3_val = (a3); !__matched; __matched = 1) \
+                            for (void *__v3 = (void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig = __v3; !__matched; __matched = 1) \
+                                for (__auto_type __v4_val = (a4); !__matched; __matched = 1) \
+                                    for (void *__v4 = (void*)MATCH_AS_INTPTR(__v4_val), *__v4_orig = __v4; !__matched; __matched = 1)
+
+#define MATCH_5(mode, a1, a2, a3, a4, a5) \
+    for (int __matched = 0, __match_strict = (mode) MATCH_PROFILE_SITE; !__matched; __matched = 1) \
+        for (__auto_type __v1_val = (a1); !__matched; __matched = 1) \
+            for (void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig = __v1; !__matched; __matched = 1) \
+                for (__auto_type __v2_val = (a2); !__matched; __matched = 1) \
+                    for (void *__v2 = (void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig = __v2; !__matched; __matched = 1) \
+                        for (__auto_type __v3_val = (a3); !__matched; __matched = 1) \
+                            for (void *__v3 = (void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig = __v3; !__matched; __matched = 1) \
+                                for (__auto_type __v4_val = (a4); !__matched; __matched = 1) \
+                                    for (void *__v4 = (void*)MATCH_AS_INTPTR(__v4_val), *__v4_orig = __v4; !__matched; __matched = 1) \
+                                        for (__auto_type __v5_val = (a5); !__matched; __matched = 1) \
+                                            for (void *__v5 = (void*)MATCH_AS_INTPTR(__v5_val), *__v5_orig = __v5; !__matched; __matched = 1)
+
+#define MATCH_6(mode, a1, a2, a3, a4, a5, a6) \
+    for (int __matched = 0, __match_strict = (mode) MATCH_PROFILE_SITE; !__matched; __matched = 1) \
+        for (__auto_type __v1_val = (a1); !__matched; __matched = 1) \
+            for (void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig = __v1; !__matched; __matched = 1) \
+                for (__auto_type __v2_val = (a2); !__matched; __matched = 1) \
+                    for (void *__v2 = (void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig = __v2; !__matched; __matched = 1) \
+                        for (__auto_type __v3_val = (a3); !__matched; __matched = 1) \
+                            for (void *__v3 = (void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig = __v3; !__matched; __matched = 1) \
+                                for (__auto_type __v4_val = (a4); !__matched; __matched = 1) \
+                                    for (void *__v4 = (void*)MATCH_AS_INTPTR(__v4_val), *__v4_orig = __v4; !__matched; __matched = 1) \
+                                        for (__auto_type __v5_val = (a5); !__matched; __matched = 1) \
+                                            for (void *__v5 = (void*)MATCH_AS_INTPTR(__v5_val), *__v5_orig = __v5; !__matched; __matched = 1) \
+                                                for (__auto_type __v6_val = (a6); !__matched; __matched = 1) \
+                                                    for (void *__v6 = (void*)MATCH_AS_INTPTR(__v6_val), *__v6_orig = __v6; !__matched; __matched = 1)
+
+#define MATCH_7(mode, a1, a2, a3, a4, a5, a6, a7) \
+    for (int __matched = 0, __match_strict = (mode) MATCH_PROFILE_SITE; !__matched; __matched = 1) \
+        for (__auto_type __v1_val = (a1); !__matched; __matched = 1) \
+            for (void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig = __v1; !__matched; __matched = 1) \
+                for (__auto_type __v2_val = (a2); !__matched; __matched = 1) \
+                    for (void *__v2 = (void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig = __v2; !__matched; __matched = 1) \
+                        for (__auto_type __v3_val = (a3); !__matched; __matched = 1) \
+                            for (void *__v3 = (void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig = __v3; !__matched; __matched = 1) \
+                                for (__auto_type __v4_val = (a4); !__matched; __matched = 1) \
+                                    for (void *__v4 = (void*)MATCH_AS_INTPTR(__v4_val), *__v4_orig = __v4; !__matched; __matched = 1) \
+                                        for (__auto_type __v5_val = (a5); !__matched; __matched = 1) \
+                                            for (void *__v5 = (void*)MATCH_AS_INTPTR(__v5_val), *__v5_orig = __v5; !__matched; __matched = 1) \
+                                                for (__auto_type __v6_val = (a6); !__matched; __matched = 1) \
+                                                    for (void *__v6 = (void*)MATCH_AS_INTPTR(__v6_val), *__v6_orig = __v6; !__matched; __matched = 1) \
+                                                        for (__auto_type __v7_val = (a7); !__matched; __matched = 1) \
+                                                            for (void *__v7 = (void*)MATCH_AS_INTPTR(__v7_val), *__v7_orig = __v7; !__matched; __matched = 1)
+
+#define MATCH_8(mode, a1, a2, a3, a4, a5, a6, a7, a8) \
+    for (int __matched = 0, __match_strict = (mode) MATCH_PROFILE_SITE; !__matched; __matched = 1) \
+        for (__auto_type __v1_val = (a1); !__matched; __matched = 1) \
+            for (void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig = __v1; !__matched; __matched = 1) \
+                for (__auto_type __v2_val = (a2); !__matched; __matched = 1) \
+                    for (void *__v2 = (void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig = __v2; !__matched; __matched = 1) \
+                        for (__auto_type __v3_val = (a3); !__matched; __matched = 1) \
+                            for (void *__v3 = (void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig = __v3; !__matched; __matched = 1) \
+                                for (__auto_type __v4_val = (a4); !__matched; __matched = 1) \
+                                    for (void *__v4 = (void*)MATCH_AS_INTPTR(__v4_val), *__v4_orig = __v4; !__matched; __matched = 1) \
+                                        for (__auto_type __v5_val = (a5); !__matched; __matched = 1) \
+                                            for (void *__v5 = (void*)MATCH_AS_INTPTR(__v5_val), *__v5_orig = __v5; !__matched; __matched = 1) \
+                                                for (__auto_type __v6_val = (a6); !__matched; __matched = 1) \
+                                                    for (void *__v6 = (void*)MATCH_AS_INTPTR(__v6_val), *__v6_orig = __v6; !__matched; __matched = 1) \
+                                                        for (__auto_type __v7_val = (a7); !__matched; __matched = 1) \
+                                                            for (void *__v7 = (void*)MATCH_AS_INTPTR(__v7_val), *__v7_orig = __v7; !__matched; __matched = 1) \
+                                                                for (__auto_type __v8_val = (a8); !__matched; __matched = 1) \
+                                                                    for (void *__v8 = (void*)MATCH_AS_INTPTR(__v8_val), *__v8_orig = __v8; !__matched; __matched = 1)
+
+#define MATCH_9(mode, a1, a2, a3, a4, a5, a6, a7, a8, a9) \
+    for (int __matched = 0, __match_strict = (mode) MATCH_PROFILE_SITE; !__matched; __matched = 1) \
+        for (__auto_type __v1_val = (a1); !__matched; __matched = 1) \
+            for (void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig = __v1; !__matched; __matched = 1) \
+                for (__auto_type __v2_val = (a2); !__matched; __matched = 1) \
+                    for (void *__v2 = (void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig = __v2; !__matched; __matched = 1) \
+                        for (__auto_type __v3_val = (a3); !__matched; __matched = 1) \
+                            for (void *__v3 = (void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig = __v3; !__matched; __matched = 1) \
+                                for (__auto_type __v4_val = (a4); !__matched; __matched = 1) \
+                                    for (void *__v4 = (void*)MATCH_AS_INTPTR(__v4_val), *__v4_orig = __v4; !__matched; __matched = 1) \
+                                        for (__auto_type __v5_val = (a5); !__matched; __matched = 1) \
+                                            for (void *__v5 = (void*)MATCH_AS_INTPTR(__v5_val), *__v5_orig = __v5; !__matched; __matched = 1) \
+                                                for (__auto_type __v6_val = (a6); !__matched; __matched = 1) \
+                                                    for (void *__v6 = (void*)MATCH_AS_INTPTR(__v6_val), *__v6_orig = __v6; !__matched; __matched = 1) \
+                                                        for (__auto_type __v7_val = (a7); !__matched; __matched = 1) \
+                                                            for (void *__v7 = (void*)MATCH_AS_INTPTR(__v7_val), *__v7_orig = __v7; !__matched; __matched = 1) \
+                                                                for (__auto_type __v8_val = (a8); !__matched; __matched = 1) \
+                                                                    for (void *__v8 = (void*)MATCH_AS_INTPTR(__v8_val), *__v8_orig = __v8; !__matched; __matched = 1) \
+                                                                        for (__auto_type __v9_val = (a9); !__matched; __matched = 1) \
+                                                                            for (void *__v9 = (void*)MATCH_AS_INTPTR(__v9_val), *__v9_orig = __v9; !__matched; __matched = 1)
+
+#define MATCH_10(mode, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10) \
+    for (int __matched = 0, __match_strict = (mode) MATCH_PROFILE_SITE; !__matched; __matched = 1) \
+        for (__auto_type __v1_val = (a1); !__matched; __matched = 1) \
+            for (void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig = __v1; !__matched; __matched = 1) \
+                for (__auto_type __v2_val = (a2); !__matched; __matched = 1) \
+                    for (void *__v2 = (void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig = __v2; !__matched; __matched = 1) \
+                        for (__auto_type __v3_val = (a3); !__matched; __matched = 1) \
+                            for (void *__v3 = (void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig = __v3; !__matched; __matched = 1) \
+                                for (__auto_type __v4_val = (a4); !__matched; __matched = 1) \
+                                    for (void *__v4 = (void*)MATCH_AS_INTPTR(__v4_val), *__v4_orig = __v4; !__matched; __matched = 1) \
+                                        for (__auto_type __v5_val = (a5); !__matched; __matched = 1) \
+                                            for (void *__v5 = (void*)MATCH_AS_INTPTR(__v5_val), *__v5_orig = __v5; !__matched; __matched = 1) \
+                                                for (__auto_type __v6_val = (a6); !__matched; __matched = 1) \
+                                                    for (void *__v6 = (void*)MATCH_AS_INTPTR(__v6_val), *__v6_orig = __v6; !__matched; __matched = 1) \
+                                                        for (__auto_type __v7_val = (a7); !__matched; __matched = 1) \
+                                                            for (void *__v7 = (void*)MATCH_AS_INTPTR(__v7_val), *__v7_orig = __v7; !__matched; __matched = 1) \
+                                                                for (__auto_type __v8_val = (a8); !__matched; __matched = 1) \
+                                                                    for (void *__v8 = (void*)MATCH_AS_INTPTR(__v8_val), *__v8_orig = __v8; !__matched; __matched = 1) \
+                                                                        for (__auto_type __v9_val = (a9); !__matched; __matched = 1) \
+                                                                            for (void *__v9 = (void*)MATCH_AS_INTPTR(__v9_val), *__v9_orig = __v9; !__matched; __matched = 1) \
+                                                                                for (__auto_type __v10_val = (a10); !__matched; __matched = 1) \
+                                                                                    for (void *__v10 = (void*)MATCH_AS_INTPTR(__v10_val), *__v10_orig = __v10; !__matched; __matched = 1)
 
 // When clause macros
 #define when(...) WHEN_DISPATCH(COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)
@@ -636,205 +1614,301 @@ static inline int evaluate_pattern_enhanced(void* subject, intptr_t actual, void
 #define WHEN_DISPATCH_(N, ...) WHEN_##N(__VA_ARGS__)
 
 #define WHEN_1(x1) \
-    if (!__matched && evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && (__matched = 1))
+    if (!__matched && MATCH_ARM_HINT(MATCH_TEST(__v1, x1)) && MATCH_ARM_HIT(when, (__matched = 1)))
 
 #define WHEN_2(x1, x2) \
-    if (!__matched && evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && (__matched = 1))
+    if (!__matched && MATCH_ARM_HINT(MATCH_TEST(__v1, x1) && MATCH_TEST(__v2, x2)) && MATCH_ARM_HIT(when, (__matched = 1)))
 
 #define WHEN_3(x1, x2, x3) \
-    if (!__matched && evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && (__matched = 1))
+    if (!__matched && MATCH_ARM_HINT(MATCH_TEST(__v1, x1) && MATCH_TEST(__v2, x2) && MATCH_TEST(__v3, x3)) && MATCH_ARM_HIT(when, (__matched = 1)))
 
 #define WHEN_4(x1, x2, x3, x4) \
-    if (!__matched && evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && (__matched = 1))
+    if (!__matched && MATCH_ARM_HINT(MATCH_TEST(__v1, x1) && MATCH_TEST(__v2, x2) && MATCH_TEST(__v3, x3) && MATCH_TEST(__v4, x4)) && MATCH_ARM_HIT(when, (__matched = 1)))
 
 #define WHEN_5(x1, x2, x3, x4, x5) \
-    if (!__matched && evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && evaluate_pattern_enhanced(__v5_orig, (intptr_t)__v5, _auto_pattern(x5)) && (__matched = 1))
+    if (!__matched && MATCH_ARM_HINT(MATCH_TEST(__v1, x1) && MATCH_TEST(__v2, x2) && MATCH_TEST(__v3, x3) && MATCH_TEST(__v4, x4) && MATCH_TEST(__v5, x5)) && MATCH_ARM_HIT(when, (__matched = 1)))
 
 #define WHEN_6(x1, x2, x3, x4, x5, x6) \
     if (!__matched && \
-        evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && \
-        evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && \
-        evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && \
-        evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && \
-        evaluate_pattern_enhanced(__v5_orig, (intptr_t)__v5, _auto_pattern(x5)) && \
-        evaluate_pattern_enhanced(__v6_orig, (intptr_t)__v6, _auto_pattern(x6)) && (__matched = 1))
+        MATCH_ARM_HINT(MATCH_TEST(__v1, x1) && \
+                       MATCH_TEST(__v2, x2) && \
+                       MATCH_TEST(__v3, x3) && \
+                       MATCH_TEST(__v4, x4) && \
+                       MATCH_TEST(__v5, x5) && \
+                       MATCH_TEST(__v6, x6)) && MATCH_ARM_HIT(when, (__matched = 1)))
 
 #define WHEN_7(x1, x2, x3, x4, x5, x6, x7) \
     if (!__matched && \
-        evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && \
-        evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && \
-        evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && \
-        evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && \
-        evaluate_pattern_enhanced(__v5_orig, (intptr_t)__v5, _auto_pattern(x5)) && \
-        evaluate_pattern_enhanced(__v6_orig, (intptr_t)__v6, _auto_pattern(x6)) && \
-        evaluate_pattern_enhanced(__v7_orig, (intptr_t)__v7, _auto_pattern(x7)) && (__matched = 1))
+        MATCH_ARM_HINT(MATCH_TEST(__v1, x1) && \
+                       MATCH_TEST(__v2, x2) && \
+                       MATCH_TEST(__v3, x3) && \
+                       MATCH_TEST(__v4, x4) && \
+                       MATCH_TEST(__v5, x5) && \
+                       MATCH_TEST(__v6, x6) && \
+                       MATCH_TEST(__v7, x7)) && MATCH_ARM_HIT(when, (__matched = 1)))
 
 #define WHEN_8(x1, x2, x3, x4, x5, x6, x7, x8) \
     if (!__matched && \
-        evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && \
-        evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && \
-        evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && \
-        evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && \
-        evaluate_pattern_enhanced(__v5_orig, (intptr_t)__v5, _auto_pattern(x5)) && \
-        evaluate_pattern_enhanced(__v6_orig, (intptr_t)__v6, _auto_pattern(x6)) && \
-        evaluate_pattern_enhanced(__v7_orig, (intptr_t)__v7, _auto_pattern(x7)) && \
-        evaluate_pattern_enhanced(__v8_orig, (intptr_t)__v8, _auto_pattern(x8)) && (__matched = 1))
+        MATCH_ARM_HINT(MATCH_TEST(__v1, x1) && \
+                       MATCH_TEST(__v2, x2) && \
+                       MATCH_TEST(__v3, x3) && \
+                       MATCH_TEST(__v4, x4) && \
+                       MATCH_TEST(__v5, x5) && \
+                       MATCH_TEST(__v6, x6) && \
+                       MATCH_TEST(__v7, x7) && \
+                       MATCH_TEST(__v8, x8)) && MATCH_ARM_HIT(when, (__matched = 1)))
 
 #define WHEN_9(x1, x2, x3, x4, x5, x6, x7, x8, x9) \
     if (!__matched && \
-        evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && \
-        evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && \
-        evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && \
-        evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && \
-        evaluate_pattern_enhanced(__v5_orig, (intptr_t)__v5, _auto_pattern(x5)) && \
-        evaluate_pattern_enhanced(__v6_orig, (intptr_t)__v6, _auto_pattern(x6)) && \
-        evaluate_pattern_enhanced(__v7_orig, (intptr_t)__v7, _auto_pattern(x7)) && \
-        evaluate_pattern_enhanced(__v8_orig, (intptr_t)__v8, _auto_pattern(x8)) && \
-        evaluate_pattern_enhanced(__v9_orig, (intptr_t)__v9, _auto_pattern(x9)) && (__matched = 1))
+        MATCH_ARM_HINT(MATCH_TEST(__v1, x1) && \
+                       MATCH_TEST(__v2, x2) && \
+                       MATCH_TEST(__v3, x3) && \
+                       MATCH_TEST(__v4, x4) && \
+                       MATCH_TEST(__v5, x5) && \
+                       MATCH_TEST(__v6, x6) && \
+                       MATCH_TEST(__v7, x7) && \
+                       MATCH_TEST(__v8, x8) && \
+                       MATCH_TEST(__v9, x9)) && MATCH_ARM_HIT(when, (__matched = 1)))
 
 #define WHEN_10(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10) \
     if (!__matched && \
-        evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && \
-        evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && \
-        evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && \
-        evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && \
-        evaluate_pattern_enhanced(__v5_orig, (intptr_t)__v5, _auto_pattern(x5)) && \
-        evaluate_pattern_enhanced(__v6_orig, (intptr_t)__v6, _auto_pattern(x6)) && \
-        evaluate_pattern_enhanced(__v7_orig, (intptr_t)__v7, _auto_pattern(x7)) && \
-        evaluate_pattern_enhanced(__v8_orig, (intptr_t)__v8, _auto_pattern(x8)) && \
-        evaluate_pattern_enhanced(__v9_orig, (intptr_t)__v9, _auto_pattern(x9)) && \
-        evaluate_pattern_enhanced(__v10_orig, (intptr_t)__v10, _auto_pattern(x10)) && (__matched = 1))
+        MATCH_ARM_HINT(MATCH_TEST(__v1, x1) && \
+                       MATCH_TEST(__v2, x2) && \
+                       MATCH_TEST(__v3, x3) && \
+                       MATCH_TEST(__v4, x4) && \
+                       MATCH_TEST(__v5, x5) && \
+                       MATCH_TEST(__v6, x6) && \
+                       MATCH_TEST(__v7, x7) && \
+                       MATCH_TEST(__v8, x8) && \
+                       MATCH_TEST(__v9, x9) && \
+                       MATCH_TEST(__v10, x10)) && MATCH_ARM_HIT(when, (__matched = 1)))
+
+#define otherwise else if (!__matched && MATCH_ARM_HIT(otherwise, (__matched = 1)))
 
-#define otherwise else if (!__matched && (__matched = 1))
+// ============================================================================
+// Switch Form: match_switch() { when_case() { ... } otherwise { ... } }
+// ============================================================================
+
+// For dense integer literals (opcodes, message types) the if-chain of when()
+// is O(arms). match_switch() expands to a real C switch over the subject, so
+// the compiler can emit a jump table; otherwise is reached through default.
+//
+//   match_switch(msg->type) {
+//       when_case(MSG_HELLO) { handle_hello(msg); }
+//       when_case(MSG_DATA, MSG_DATA_LAST) { handle_data(msg); }
+//       otherwise { drop(msg); }
+//   }
+//
+// The default label sits in front of the arms. Each arm is
+// "if (0) case ...: while (once) { body }", so the only way into a body is
+// its case label, and a finished body (or break) skips the remaining if (0)
+// arms and the already-matched otherwise. Unmatched values start at the top,
+// skip every arm and land in otherwise. Case values must be integer constant
+// expressions, as for any switch.
+#define match_switch(x) \
+    for (int __matched = 0 MATCH_PROFILE_SITE; !__matched; __matched = 1) \
+        switch (x) default:
+
+#define when_case(...) \
+    if (0) WHEN_CASE_DISPATCH(COUNT_ARGS(__VA_ARGS__), __VA_ARGS__) \
+        while (!__matched && MATCH_ARM_HIT(case, (__matched = 1)))
+#define WHEN_CASE_DISPATCH(N, ...) WHEN_CASE_DISPATCH_(N, __VA_ARGS__)
+#define WHEN_CASE_DISPATCH_(N, ...) WHEN_CASE_##N(__VA_ARGS__)
+
+#define WHEN_CASE_1(x1) case (x1):
+#define WHEN_CASE_2(x1, x2) case (x1): WHEN_CASE_1(x2)
+#define WHEN_CASE_3(x1, x2, x3) case (x1): WHEN_CASE_2(x2, x3)
+#define WHEN_CASE_4(x1, x2, x3, x4) case (x1): WHEN_CASE_3(x2, x3, x4)
+#define WHEN_CASE_5(x1, x2, x3, x4, x5) case (x1): WHEN_CASE_4(x2, x3, x4, x5)
+#define WHEN_CASE_6(x1, x2, x3, x4, x5, x6) case (x1): WHEN_CASE_5(x2, x3, x4, x5, x6)
+#define WHEN_CASE_7(x1, x2, x3, x4, x5, x6, x7) case (x1): WHEN_CASE_6(x2, x3, x4, x5, x6, x7)
+#define WHEN_CASE_8(x1, x2, x3, x4, x5, x6, x7, x8) case (x1): WHEN_CASE_7(x2, x3, x4, x5, x6, x7, x8)
+#define WHEN_CASE_9(x1, x2, x3, x4, x5, x6, x7, x8, x9) case (x1): WHEN_CASE_8(x2, x3, x4, x5, x6, x7, x8, x9)
+#define WHEN_CASE_10(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10) case (x1): WHEN_CASE_9(x2, x3, x4, x5, x6, x7, x8, x9, x10)
 
 // ============================================================================
 // Expression Form: match_expr() in( is() ? ... : ... )
 // Clean alias: let() in( is() ? ... : ... )
 // ============================================================================
 
-#define match_expr(...) MATCH_EXPR_DISPATCH(COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)
+#define match_expr(...) MATCH_EXPR_DISPATCH(MATCH_DEFAULT_MODE, COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)
+#define match_expr_strict(...) MATCH_EXPR_DISPATCH(MATCH_MODE_STRICT, COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)
+#define match_expr_auto(...) MATCH_EXPR_DISPATCH(MATCH_MODE_AUTO, COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)
 #define let(...) match_expr(__VA_ARGS__)  // Clean alias for match_expr
-#define MATCH_EXPR_DISPATCH(N, ...) MATCH_EXPR_DISPATCH_(N, __VA_ARGS__)
-#define MATCH_EXPR_DISPATCH_(N, ...) MATCH_EXPR_##N(__VA_ARGS__)
+#define let_strict(...) match_expr_strict(__VA_ARGS__)
+#define let_auto(...) match_expr_auto(__VA_ARGS__)
+#define MATCH_EXPR_DISPATCH(mode, N, ...) MATCH_EXPR_DISPATCH_(mode, N, __VA_ARGS__)
+#define MATCH_EXPR_DISPATCH_(mode, N, ...) MATCH_EXPR_##N(mode, __VA_ARGS__)
 
-#define MATCH_EXPR_1(a1) \
-    ({ __auto_type __v1_val = (a1); \
+#define MATCH_EXPR_1(mode, a1) \
+    ({ const int __match_strict = (mode) MATCH_PROFILE_SITE; __auto_type __v1_val = (a1); \
        void *__v1_orig = (void*)&__v1_val; \
-       intptr_t __v1_int = _Generic(__v1_val, \
-        float: (intptr_t)(*(uint32_t*)&__v1_val), \
-        double: (intptr_t)(*(uint64_t*)&__v1_val), \
-        default: (intptr_t)(__v1_val)); \
+       intptr_t __v1_int = MATCH_AS_INTPTR(__v1_val); \
        void *__v1 = (void*)__v1_int; \
        __auto_type __result =
 
-#define MATCH_EXPR_2(a1, a2) \
-    ({ __auto_type __v1_val = (a1); __auto_type __v2_val = (a2); \
+#define MATCH_EXPR_2(mode, a1, a2) \
+    ({ const int __match_strict = (mode) MATCH_PROFILE_SITE; __auto_type __v1_val = (a1); __auto_type __v2_val = (a2); \
        void *__v1_orig = (void*)&__v1_val; void *__v2_orig = (void*)&__v2_val; \
-       intptr_t __v1_int = _Generic(__v1_val, \
-        float: (intptr_t)(*(uint32_t*)&__v1_val), \
-        double: (intptr_t)(*(uint64_t*)&__v1_val), \
-        default: (intptr_t)(__v1_val)); \
-       intptr_t __v2_int = _Generic(__v2_val, \
-        float: (intptr_t)(*(uint32_t*)&__v2_val), \
-        double: (intptr_t)(*(uint64_t*)&__v2_val), \
-        default: (intptr_t)(__v2_val)); \
+       intptr_t __v1_int = MATCH_AS_INTPTR(__v1_val); \
+       intptr_t __v2_int = MATCH_AS_INTPTR(__v2_val); \
        void *__v1 = (void*)__v1_int; void *__v2 = (void*)__v2_int; \
        __auto_type __result =
 
-#define MATCH_EXPR_3(a1, a2, a3) \
-    ({ void *__v1 = (void*)(intptr_t)(a1); void *__v1_orig = (void*)(a1); void *__v2 = (void*)(intptr_t)(a2); void *__v2_orig = (void*)(a2); void *__v3 = (void*)(intptr_t)(a3); void *__v3_orig = (void*)(a3); __auto_type __result =
+#define MATCH_EXPR_3(mode, a1, a2, a3) \
+    ({ const int __match_strict = (mode) MATCH_PROFILE_SITE; __auto_type __v1_val = (a1); __auto_type __v2_val = (a2); __auto_type __v3_val = (a3); \
+       void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val); void *__v1_orig = (void*)MATCH_AS_INTPTR(__v1_val); void *__v2 = (void*)MATCH_AS_INTPTR(__v2_val); void *__v2_orig = (void*)MATCH_AS_INTPTR(__v2_val); void *__v3 = (void*)MATCH_AS_INTPTR(__v3_val); void *__v3_orig = (void*)MATCH_AS_INTPTR(__v3_val); __auto_type __result =
+
+#define MATCH_EXPR_4(mode, a1, a2, a3, a4) \
+    ({ const int __match_strict = (mode) MATCH_PROFILE_SITE; __auto_type __v1_val = (a1); __auto_type __v2_val = (a2); __auto_type __v3_val = (a3); __auto_type __v4_val = (a4); \
+       void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val); void *__v1_orig = (void*)MATCH_AS_INTPTR(__v1_val); void *__v2 = (void*)MATCH_AS_INTPTR(__v2_val); void *__v2_orig = (void*)MATCH_AS_INTPTR(__v2_val); void *__v3 = (void*)MATCH_AS_INTPTR(__v3_val); void *__v3_orig = (void*)MATCH_AS_INTPTR(__v3_val); void *__v4 = (void*)MATCH_AS_INTPTR(__v4_val); void *__v4_orig = (void*)MATCH_AS_INTPTR(__v4_val); __auto_type __result =
+
+#define MATCH_EXPR_5(mode, a1, a2, a3, a4, a5) \
+    ({ const int __match_strict = (mode) MATCH_PROFILE_SITE; __auto_type __v1_val = (a1); __auto_type __v2_val = (a2); __auto_type __v3_val = (a3); __auto_type __v4_val = (a4); __auto_type __v5_val = (a5); \
+       void *__v1 = (void*)MATCH_AS_INTPTR(__v1_val); void *__v1_orig = (void*)MATCH_AS_INTPTR(__v1_val); void *__v2 = (void*)MATCH_AS_INTPTR(__v2_val); void *__v2_orig = (void*)MATCH_AS_INTPTR(__v2_val); void *__v3 = (void*)MATCH_AS_INTPTR(__v3_val); void *__v3_orig = (void*)MATCH_AS_INTPTR(__v3_val); void *__v4 = (void*)MATCH_AS_INTPTR(__v4_val); void *__v4_orig = (void*)MATCH_AS_INTPTR(__v4_val); void *__v5 = (void*)MATCH_AS_INTPTR(__v5_val); void *__v5_orig = (void*)MATCH_AS_INTPTR(__v5_val); __auto_type __result =
+
+#define MATCH_EXPR_6(mode, a1, a2, a3, a4, a5, a6) \
+    ({ const int __match_strict = (mode) MATCH_PROFILE_SITE; __auto_type __v1_val = (a1); __auto_type __v2_val = (a2); __auto_type __v3_val = (a3); __auto_type __v4_val = (a4); __auto_type __v5_val = (a5); __auto_type __v6_val = (a6); \
+       void *__v1=(void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig=(void*)MATCH_AS_INTPTR(__v1_val), *__v2=(void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig=(void*)MATCH_AS_INTPTR(__v2_val), *__v3=(void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig=(void*)MATCH_AS_INTPTR(__v3_val), \
+        *__v4=(void*)MATCH_AS_INTPTR(__v4_val), *__v4_orig=(void*)MATCH_AS_INTPTR(__v4_val), *__v5=(void*)MATCH_AS_INTPTR(__v5_val), *__v5_orig=(void*)MATCH_AS_INTPTR(__v5_val), *__v6=(void*)MATCH_AS_INTPTR(__v6_val), *__v6_orig=(void*)MATCH_AS_INTPTR(__v6_val); __auto_type __result =
+
+#define MATCH_EXPR_7(mode, a1, a2, a3, a4, a5, a6, a7) \
+    ({ const int __match_strict = (mode) MATCH_PROFILE_SITE; __auto_type __v1_val = (a1); __auto_type __v2_val = (a2); __auto_type __v3_val = (a3); __auto_type __v4_val = (a4); __auto_type __v5_val = (a5); __auto_type __v6_val = (a6); __auto_type __v7_val = (a7); \
+       void *__v1=(void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig=(void*)MATCH_AS_INTPTR(__v1_val), *__v2=(void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig=(void*)MATCH_AS_INTPTR(__v2_val), *__v3=(void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig=(void*)MATCH_AS_INTPTR(__v3_val), \
+        *__v4=(void*)MATCH_AS_INTPTR(__v4_val), *__v4_orig=(void*)MATCH_AS_INTPTR(__v4_val), *__v5=(void*)MATCH_AS_INTPTR(__v5_val), *__v5_orig=(void*)MATCH_AS_INTPTR(__v5_val), *__v6=(void*)MATCH_AS_INTPTR(__v6_val), *__v6_orig=(void*)MATCH_AS_INTPTR(__v6_val), \
+        *__v7=(void*)MATCH_AS_INTPTR(__v7_val), *__v7_orig=(void*)MATCH_AS_INTPTR(__v7_val); __auto_type __result =
+
+#define MATCH_EXPR_8(mode, a1, a2, a3, a4, a5, a6, a7, a8) \
+    ({ const int __match_strict = (mode) MATCH_PROFILE_SITE; __auto_type __v1_val = (a1); __auto_type __v2_val = (a2); __auto_type __v3_val = (a3); __auto_type __v4_val = (a4); __auto_type __v5_val = (a5); __auto_type __v6_val = (a6); __auto_type __v7_val = (a7); __auto_type __v8_val = (a8); \
+       void *__v1=(void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig=(void*)MATCH_AS_INTPTR(__v1_val), *__v2=(void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig=(void*)MATCH_AS_INTPTR(__v2_val), *__v3=(void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig=(void*)MATCH_AS_INTPTR(__v3_val), \
+        *__v4=(void*)MATCH_AS_INTPTR(__v4_val), *__v4_orig=(void*)MATCH_AS_INTPTR(__v4_val), *__v5=(void*)MATCH_AS_INTPTR(__v5_val), *__v5_orig=(void*)MATCH_AS_INTPTR(__v5_val), *__v6=(void*)MATCH_AS_INTPTR(__v6_val), *__v6_orig=(void*)MATCH_AS_INTPTR(__v6_val), \
+        *__v7=(void*)MATCH_AS_INTPTR(__v7_val), *__v7_orig=(void*)MATCH_AS_INTPTR(__v7_val), *__v8=(void*)MATCH_AS_INTPTR(__v8_val), *__v8_orig=(void*)MATCH_AS_INTPTR(__v8_val); __auto_type __result =
+
+#define MATCH_EXPR_9(mode, a1, a2, a3, a4, a5, a6, a7, a8, a9) \
+    ({ const int __match_strict = (mode) MATCH_PROFILE_SITE; __auto_type __v1_val = (a1); __auto_type __v2_val = (a2); __auto_type __v3_val = (a3); __auto_type __v4_val = (a4); __auto_type __v5_val = (a5); __auto_type __v6_val = (a6); __auto_type __v7_val = (a7); __auto_type __v8_val = (a8); __auto_type __v9_val = (a9); \
+       void *__v1=(void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig=(void*)MATCH_AS_INTPTR(__v1_val), *__v2=(void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig=(void*)MATCH_AS_INTPTR(__v2_val), *__v3=(void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig=(void*)MATCH_AS_INTPTR(__v3_val), \
+        *__v4=(void*)MATCH_AS_INTPTR(__v4_val), *__v4_orig=(void*)MATCH_AS_INTPTR(__v4_val), *__v5=(void*)MATCH_AS_INTPTR(__v5_val), *__v5_orig=(void*)MATCH_AS_INTPTR(__v5_val), *__v6=(void*)MATCH_AS_INTPTR(__v6_val), *__v6_orig=(void*)MATCH_AS_INTPTR(__v6_val), \
+        *__v7=(void*)MATCH_AS_INTPTR(__v7_val), *__v7_orig=(void*)MATCH_AS_INTPTR(__v7_val), *__v8=(void*)MATCH_AS_INTPTR(__v8_val), *__v8_orig=(void*)MATCH_AS_INTPTR(__v8_val), *__v9=(void*)MATCH_AS_INTPTR(__v9_val), *__v9_orig=(void*)MATCH_AS_INTPTR(__v9_val); __auto_type __result =
+
+#define MATCH_EXPR_10(mode, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10) \
+    ({ const int __match_strict = (mode) MATCH_PROFILE_SITE; __auto_type __v1_val = (a1); __auto_type __v2_val = (a2); __auto_type __v3_val = (a3); __auto_type __v4_val = (a4); __auto_type __v5_val = (a5); __auto_type __v6_val = (a6); __auto_type __v7_val = (a7); __auto_type __v8_val = (a8); __auto_type __v9_val = (a9); __auto_type __v10_val = (a10); \
+       void *__v1=(void*)MATCH_AS_INTPTR(__v1_val), *__v1_orig=(void*)MATCH_AS_INTPTR(__v1_val), *__v2=(void*)MATCH_AS_INTPTR(__v2_val), *__v2_orig=(void*)MATCH_AS_INTPTR(__v2_val), *__v3=(void*)MATCH_AS_INTPTR(__v3_val), *__v3_orig=(void*)MATCH_AS_INTPTR(__v3_val), \
+        *__v4=(void*)MATCH_AS_INTPTR(__v4_val), *__v4_orig=(void*)MATCH_AS_INTPTR(__v4_val), *__v5=(void*)MATCH_AS_INTPTR(__v5_val), *__v5_orig=(void*)MATCH_AS_INTPTR(__v5_val), *__v6=(void*)MATCH_AS_INTPTR(__v6_val), *__v6_orig=(void*)MATCH_AS_INTPTR(__v6_val), \
+        *__v7=(void*)MATCH_AS_INTPTR(__v7_val), *__v7_orig=(void*)MATCH_AS_INTPTR(__v7_val), *__v8=(void*)MATCH_AS_INTPTR(__v8_val), *__v8_orig=(void*)MATCH_AS_INTPTR(__v8_val), *__v9=(void*)MATCH_AS_INTPTR(__v9_val), *__v9_orig=(void*)MATCH_AS_INTPTR(__v9_val), \
+        *__v10=(void*)MATCH_AS_INTPTR(__v10_val), *__v10_orig=(void*)MATCH_AS_INTPTR(__v10_val); __auto_type __result =
 
-#define MATCH_EXPR_4(a1, a2, a3, a4) \
-    ({ void *__v1 = (void*)(intptr_t)(a1); void *__v1_orig = (void*)(a1); void *__v2 = (void*)(intptr_t)(a2); void *__v2_orig = (void*)(a2); void *__v3 = (void*)(intptr_t)(a3); void *__v3_orig = (void*)(a3); void *__v4 = (void*)(intptr_t)(a4); void *__v4_orig = (void*)(a4); __auto_type __result =
-
-#define MATCH_EXPR_5(a1, a2, a3, a4, a5) \
-    ({ void *__v1 = (void*)(intptr_t)(a1); void *__v1_orig = (void*)(a1); void *__v2 = (void*)(intptr_t)(a2); void *__v2_orig = (void*)(a2); void *__v3 = (void*)(intptr_t)(a3); void *__v3_orig = (void*)(a3); void *__v4 = (void*)(intptr_t)(a4); void *__v4_orig = (void*)(a4); void *__v5 = (void*)(intptr_t)(a5); void *__v5_orig = (void*)(a5); __auto_type __result =
+#define in(expr) (expr); __result; })
 
-#define MATCH_EXPR_6(a1, a2, a3, a4, a5, a6) \
-    ({ void *__v1=(void*)(intptr_t)(a1), *__v1_orig=(void*)(a1), *__v2=(void*)(intptr_t)(a2), *__v2_orig=(void*)(a2), *__v3=(void*)(intptr_t)(a3), *__v3_orig=(void*)(a3), \
-        *__v4=(void*)(intptr_t)(a4), *__v4_orig=(void*)(a4), *__v5=(void*)(intptr_t)(a5), *__v5_orig=(void*)(a5), *__v6=(void*)(intptr_t)(a6), *__v6_orig=(void*)(a6); __auto_type __result =
+#define is(...) IS_DISPATCH(COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)
+#define IS_DISPATCH(N, ...) IS_DISPATCH_(N, __VA_ARGS__)
+#define IS_DISPATCH_(N, ...) IS_##N(__VA_ARGS__)
 
-#define MATCH_EXPR_7(a1, a2, a3, a4, a5, a6, a7) \
-    ({ void *__v1=(void*)(intptr_t)(a1), *__v1_orig=(void*)(a1), *__v2=(void*)(intptr_t)(a2), *__v2_orig=(void*)(a2), *__v3=(void*)(intptr_t)(a3), *__v3_orig=(void*)(a3), \
-        *__v4=(void*)(intptr_t)(a4), *__v4_orig=(void*)(a4), *__v5=(void*)(intptr_t)(a5), *__v5_orig=(void*)(a5), *__v6=(void*)(intptr_t)(a6), *__v6_orig=(void*)(a6), \
-        *__v7=(void*)(intptr_t)(a7), *__v7_orig=(void*)(a7); __auto_type __result =
+#define IS_1(x1) MATCH_ARM_HIT(is, MATCH_ARM_HINT(MATCH_TESTS_1(x1)))
+#define IS_2(x1, x2) MATCH_ARM_HIT(is, MATCH_ARM_HINT(MATCH_TESTS_2(x1, x2)))
+#define IS_3(x1, x2, x3) MATCH_ARM_HIT(is, MATCH_ARM_HINT(MATCH_TESTS_3(x1, x2, x3)))
+#define IS_4(x1, x2, x3, x4) MATCH_ARM_HIT(is, MATCH_ARM_HINT(MATCH_TESTS_4(x1, x2, x3, x4)))
+#define IS_5(x1, x2, x3, x4, x5) MATCH_ARM_HIT(is, MATCH_ARM_HINT(MATCH_TESTS_5(x1, x2, x3, x4, x5)))
+#define IS_6(x1, x2, x3, x4, x5, x6) MATCH_ARM_HIT(is, MATCH_ARM_HINT(MATCH_TESTS_6(x1, x2, x3, x4, x5, x6)))
+#define IS_7(x1, x2, x3, x4, x5, x6, x7) MATCH_ARM_HIT(is, MATCH_ARM_HINT(MATCH_TESTS_7(x1, x2, x3, x4, x5, x6, x7)))
+#define IS_8(x1, x2, x3, x4, x5, x6, x7, x8) MATCH_ARM_HIT(is, MATCH_ARM_HINT(MATCH_TESTS_8(x1, x2, x3, x4, x5, x6, x7, x8)))
+#define IS_9(x1, x2, x3, x4, x5, x6, x7, x8, x9) MATCH_ARM_HIT(is, MATCH_ARM_HINT(MATCH_TESTS_9(x1, x2, x3, x4, x5, x6, x7, x8, x9)))
+#define IS_10(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10) MATCH_ARM_HIT(is, MATCH_ARM_HINT(MATCH_TESTS_10(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10)))
+
+// Pattern conjunction of an arm, shared by is() and the annotated arms below
+#define MATCH_TESTS(...) MATCH_TESTS_DISPATCH(COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)
+#define MATCH_TESTS_DISPATCH(N, ...) MATCH_TESTS_DISPATCH_(N, __VA_ARGS__)
+#define MATCH_TESTS_DISPATCH_(N, ...) MATCH_TESTS_##N(__VA_ARGS__)
+
+#define MATCH_TESTS_1(x1) MATCH_TEST(__v1, x1)
+#define MATCH_TESTS_2(x1, x2) (MATCH_TEST(__v1, x1) && MATCH_TEST(__v2, x2))
+#define MATCH_TESTS_3(x1, x2, x3) (MATCH_TEST(__v1, x1) && MATCH_TEST(__v2, x2) && MATCH_TEST(__v3, x3))
+#define MATCH_TESTS_4(x1, x2, x3, x4) (MATCH_TEST(__v1, x1) && MATCH_TEST(__v2, x2) && MATCH_TEST(__v3, x3) && MATCH_TEST(__v4, x4))
+#define MATCH_TESTS_5(x1, x2, x3, x4, x5) (MATCH_TEST(__v1, x1) && MATCH_TEST(__v2, x2) && MATCH_TEST(__v3, x3) && MATCH_TEST(__v4, x4) && MATCH_TEST(__v5, x5))
+
+#define MATCH_TESTS_6(x1, x2, x3, x4, x5, x6) \
+    (MATCH_TEST(__v1, x1) && \
+     MATCH_TEST(__v2, x2) && \
+     MATCH_TEST(__v3, x3) && \
+     MATCH_TEST(__v4, x4) && \
+     MATCH_TEST(__v5, x5) && \
+     MATCH_TEST(__v6, x6))
+
+#define MATCH_TESTS_7(x1, x2, x3, x4, x5, x6, x7) \
+    (MATCH_TEST(__v1, x1) && \
+     MATCH_TEST(__v2, x2) && \
+     MATCH_TEST(__v3, x3) && \
+     MATCH_TEST(__v4, x4) && \
+     MATCH_TEST(__v5, x5) && \
+     MATCH_TEST(__v6, x6) && \
+     MATCH_TEST(__v7, x7))
+
+#define MATCH_TESTS_8(x1, x2, x3, x4, x5, x6, x7, x8) \
+    (MATCH_TEST(__v1, x1) && \
+     MATCH_TEST(__v2, x2) && \
+     MATCH_TEST(__v3, x3) && \
+     MATCH_TEST(__v4, x4) && \
+     MATCH_TEST(__v5, x5) && \
+     MATCH_TEST(__v6, x6) && \
+     MATCH_TEST(__v7, x7) && \
+     MATCH_TEST(__v8, x8))
+
+#define MATCH_TESTS_9(x1, x2, x3, x4, x5, x6, x7, x8, x9) \
+    (MATCH_TEST(__v1, x1) && \
+     MATCH_TEST(__v2, x2) && \
+     MATCH_TEST(__v3, x3) && \
+     MATCH_TEST(__v4, x4) && \
+     MATCH_TEST(__v5, x5) && \
+     MATCH_TEST(__v6, x6) && \
+     MATCH_TEST(__v7, x7) && \
+     MATCH_TEST(__v8, x8) && \
+     MATCH_TEST(__v9, x9))
+
+#define MATCH_TESTS_10(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10) \
+    (MATCH_TEST(__v1, x1) && \
+     MATCH_TEST(__v2, x2) && \
+     MATCH_TEST(__v3, x3) && \
+     MATCH_TEST(__v4, x4) && \
+     MATCH_TEST(__v5, x5) && \
+     MATCH_TEST(__v6, x6) && \
+     MATCH_TEST(__v7, x7) && \
+     MATCH_TEST(__v8, x8) && \
+     MATCH_TEST(__v9, x9) && \
+     MATCH_TEST(__v10, x10))
 
-#define MATCH_EXPR_8(a1, a2, a3, a4, a5, a6, a7, a8) \
-    ({ void *__v1=(void*)(intptr_t)(a1), *__v1_orig=(void*)(a1), *__v2=(void*)(intptr_t)(a2), *__v2_orig=(void*)(a2), *__v3=(void*)(intptr_t)(a3), *__v3_orig=(void*)(a3), \
-        *__v4=(void*)(intptr_t)(a4), *__v4_orig=(void*)(a4), *__v5=(void*)(intptr_t)(a5), *__v5_orig=(void*)(a5), *__v6=(void*)(intptr_t)(a6), *__v6_orig=(void*)(a6), \
-        *__v7=(void*)(intptr_t)(a7), *__v7_orig=(void*)(a7), *__v8=(void*)(intptr_t)(a8), *__v8_orig=(void*)(a8); __auto_type __result =
+// ============================================================================
+// Branch Annotations: when_likely() / when_unlikely() / is_cold()
+// ============================================================================
 
-#define MATCH_EXPR_9(a1, a2, a3, a4, a5, a6, a7, a8, a9) \
-    ({ void *__v1=(void*)(intptr_t)(a1), *__v1_orig=(void*)(a1), *__v2=(void*)(intptr_t)(a2), *__v2_orig=(void*)(a2), *__v3=(void*)(intptr_t)(a3), *__v3_orig=(void*)(a3), \
-        *__v4=(void*)(intptr_t)(a4), *__v4_orig=(void*)(a4), *__v5=(void*)(intptr_t)(a5), *__v5_orig=(void*)(a5), *__v6=(void*)(intptr_t)(a6), *__v6_orig=(void*)(a6), \
-        *__v7=(void*)(intptr_t)(a7), *__v7_orig=(void*)(a7), *__v8=(void*)(intptr_t)(a8), *__v8_orig=(void*)(a8), *__v9=(void*)(intptr_t)(a9), *__v9_orig=(void*)(a9); __auto_type __result =
+// For arms whose frequency is known up front (errors, slow paths), without
+// recording a profile first:
+//
+//   match(&result) {
+//       when(Result_Ok) { total += result.Ok; }
+//       when_unlikely(Result_Err) { log_error("parse", result.Err); }
+//   }
+//
+// when_likely() and when_unlikely() test their patterns through
+// __builtin_expect. A cold arm also calls match_cold_path() once it matched:
+// GCC treats every block only reachable through a call to a cold function as
+// never executed, so the arm's body is moved to function.cold in
+// .text.unlikely and the hot path stays contiguous. is_cold() does the same
+// for the value after its '?'. The price is one call to an empty function
+// on the cold path.
+//
+// These arms ignore MATCH_HINTS, and MATCH_PROFILE counts them as when/is.
+__attribute__((cold, noinline, unused)) static void match_cold_path(void) {
+    __asm__ volatile("");  // not a pure function, so the call is kept
+}
 
-#define MATCH_EXPR_10(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10) \
-    ({ void *__v1=(void*)(intptr_t)(a1), *__v1_orig=(void*)(a1), *__v2=(void*)(intptr_t)(a2), *__v2_orig=(void*)(a2), *__v3=(void*)(intptr_t)(a3), *__v3_orig=(void*)(a3), \
-        *__v4=(void*)(intptr_t)(a4), *__v4_orig=(void*)(a4), *__v5=(void*)(intptr_t)(a5), *__v5_orig=(void*)(a5), *__v6=(void*)(intptr_t)(a6), *__v6_orig=(void*)(a6), \
-        *__v7=(void*)(intptr_t)(a7), *__v7_orig=(void*)(a7), *__v8=(void*)(intptr_t)(a8), *__v8_orig=(void*)(a8), *__v9=(void*)(intptr_t)(a9), *__v9_orig=(void*)(a9), \
-        *__v10=(void*)(intptr_t)(a10), *__v10_orig=(void*)(a10); __auto_type __result =
+#define when_likely(...) \
+    if (!__matched && __builtin_expect(!!(MATCH_TESTS(__VA_ARGS__)), 1) && MATCH_ARM_HIT(when, (__matched = 1)))
 
-#define in(expr) (expr); __result; })
+#define when_unlikely(...) \
+    if (!__matched && __builtin_expect(!!(MATCH_TESTS(__VA_ARGS__)), 0) && MATCH_ARM_HIT(when, (__matched = 1)) && \
+        (match_cold_path(), 1))
 
-#define is(...) IS_DISPATCH(COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)
-#define IS_DISPATCH(N, ...) IS_DISPATCH_(N, __VA_ARGS__)
-#define IS_DISPATCH_(N, ...) IS_##N(__VA_ARGS__)
+#define is_cold(...) MATCH_ARM_HIT(is, (__builtin_expect(!!(MATCH_TESTS(__VA_ARGS__)), 0) && (match_cold_path(), 1)))
 
-#define IS_1(x1) evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1))
-#define IS_2(x1, x2) (evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)))
-#define IS_3(x1, x2, x3) (evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)))
-#define IS_4(x1, x2, x3, x4) (evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)))
-#define IS_5(x1, x2, x3, x4, x5) (evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && evaluate_pattern_enhanced(__v5_orig, (intptr_t)__v5, _auto_pattern(x5)))
-#define IS_6(x1, x2, x3, x4, x5, x6) \
-    (evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && \
-     evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && \
-     evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && \
-     evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && \
-     evaluate_pattern_enhanced(__v5_orig, (intptr_t)__v5, _auto_pattern(x5)) && \
-     evaluate_pattern_enhanced(__v6_orig, (intptr_t)__v6, _auto_pattern(x6)))
-
-#define IS_7(x1, x2, x3, x4, x5, x6, x7) \
-    (evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && \
-     evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && \
-     evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && \
-     evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && \
-     evaluate_pattern_enhanced(__v5_orig, (intptr_t)__v5, _auto_pattern(x5)) && \
-     evaluate_pattern_enhanced(__v6_orig, (intptr_t)__v6, _auto_pattern(x6)) && \
-     evaluate_pattern_enhanced(__v7_orig, (intptr_t)__v7, _auto_pattern(x7)))
-
-#define IS_8(x1, x2, x3, x4, x5, x6, x7, x8) \
-    (evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && \
-     evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && \
-     evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && \
-     evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && \
-     evaluate_pattern_enhanced(__v5_orig, (intptr_t)__v5, _auto_pattern(x5)) && \
-     evaluate_pattern_enhanced(__v6_orig, (intptr_t)__v6, _auto_pattern(x6)) && \
-     evaluate_pattern_enhanced(__v7_orig, (intptr_t)__v7, _auto_pattern(x7)) && \
-     evaluate_pattern_enhanced(__v8_orig, (intptr_t)__v8, _auto_pattern(x8)))
-
-#define IS_9(x1, x2, x3, x4, x5, x6, x7, x8, x9) \
-    (evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && \
-     evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && \
-     evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && \
-     evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && \
-     evaluate_pattern_enhanced(__v5_orig, (intptr_t)__v5, _auto_pattern(x5)) && \
-     evaluate_pattern_enhanced(__v6_orig, (intptr_t)__v6, _auto_pattern(x6)) && \
-     evaluate_pattern_enhanced(__v7_orig, (intptr_t)__v7, _auto_pattern(x7)) && \
-     evaluate_pattern_enhanced(__v8_orig, (intptr_t)__v8, _auto_pattern(x8)) && \
-     evaluate_pattern_enhanced(__v9_orig, (intptr_t)__v9, _auto_pattern(x9)))
-
-#define IS_10(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10) \
-    (evaluate_pattern_enhanced(__v1_orig, (intptr_t)__v1, _auto_pattern(x1)) && \
-     evaluate_pattern_enhanced(__v2_orig, (intptr_t)__v2, _auto_pattern(x2)) && \
-     evaluate_pattern_enhanced(__v3_orig, (intptr_t)__v3, _auto_pattern(x3)) && \
-     evaluate_pattern_enhanced(__v4_orig, (intptr_t)__v4, _auto_pattern(x4)) && \
-     evaluate_pattern_enhanced(__v5_orig, (intptr_t)__v5, _auto_pattern(x5)) && \
-     evaluate_pattern_enhanced(__v6_orig, (intptr_t)__v6, _auto_pattern(x6)) && \
-     evaluate_pattern_enhanced(__v7_orig, (intptr_t)__v7, _auto_pattern(x7)) && \
-     evaluate_pattern_enhanced(__v8_orig, (intptr_t)__v8, _auto_pattern(x8)) && \
-     evaluate_pattern_enhanced(__v9_orig, (intptr_t)__v9, _auto_pattern(x9)) && \
-     evaluate_pattern_enhanced(__v10_orig, (intptr_t)__v10, _auto_pattern(x10)))
 // ============================================================================
 // Do Blocks for Complex Expressions
 // ============================================================================
@@ -856,6 +1930,367 @@ static inline int evaluate_pattern_enhanced(void* subject, intptr_t actual, void
  * The last expression in the do block becomes the return value.
  */
 
+// ============================================================================
+// Batch Form: match_batch(subjects, n, arm_out, arms...)
+// ============================================================================
+
+// Classifies a whole int32_t array against one list of single-column arms and
+// writes the index of the first matching arm for every element, or the number
+// of arms when none matches:
+//
+//   uint8_t grade[N];
+//   match_batch(scores, N, grade, ge(90), ge(80), ge(70), ge(60), __);
+//   // grade[i] == 0 for 'A', 1 for 'B', ... 4 for the wildcard
+//
+// Every arm is flattened to an inclusive int32 interval (ne() to its
+// complement), so the kernel is two compares and a blend per arm, walking the
+// arms last to first so the earliest match wins. AVX2 (8 lanes) or SSE4.2
+// (4 lanes) is picked at runtime on x86; other targets, and arms without an
+// interval form (variant(), unsigned ranges that reach past INT32_MAX), use
+// the scalar loop.
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MATCH_BATCH_X86 1
+#include <immintrin.h>
+#else
+#define MATCH_BATCH_X86 0
+#endif
+
+#define MATCH_BATCH_MAX_ARMS 255
+
+typedef struct {
+    int32_t lo;          // inclusive bounds; lo > hi never matches
+    int32_t hi;
+    int32_t invert;      // match everything outside [lo, hi]
+} MatchBatchArm;
+
+// Returns 0 when the pattern can't be expressed as an int32 interval
+static inline int match_batch_arm(MatchPattern pattern, MatchBatchArm *arm) {
+    int64_t lo = INT64_MIN, hi = INT64_MAX;
+    arm->invert = 0;
+    switch (pattern.kind) {
+        case MATCH_PAT_ANY: break;
+        case MATCH_PAT_EQ: lo = hi = pattern.lo; break;
+        case MATCH_PAT_NE: lo = hi = pattern.lo; arm->invert = 1; break;
+        case MATCH_PAT_GT: if (pattern.lo == INT64_MAX) lo = 1, hi = 0; else lo = pattern.lo + 1; break;
+        case MATCH_PAT_GE: lo = pattern.lo; break;
+        case MATCH_PAT_LT: if (pattern.lo == INT64_MIN) lo = 1, hi = 0; else hi = pattern.lo - 1; break;
+        case MATCH_PAT_LE: hi = pattern.lo; break;
+        case MATCH_PAT_RANGE:
+        case MATCH_PAT_URANGE:
+            if (pattern.lo == INT64_MAX || pattern.hi == INT64_MIN) lo = 1, hi = 0;
+            else lo = pattern.lo + 1, hi = pattern.hi - 1;
+            break;
+        case MATCH_PAT_BETWEEN:
+        case MATCH_PAT_UBETWEEN: lo = pattern.lo; hi = pattern.hi; break;
+        default: return 0;
+    }
+    // A negative int32 compares unsigned as a huge value, so unsigned ranges
+    // only map onto int32 while both bounds sit in [0, INT64_MAX]
+    if ((pattern.kind == MATCH_PAT_URANGE || pattern.kind == MATCH_PAT_UBETWEEN) &&
+        (pattern.lo < 0 || pattern.hi < 0)) {
+        return 0;
+    }
+    if (lo < INT32_MIN) lo = INT32_MIN;
+    if (hi > INT32_MAX) hi = INT32_MAX;
+    if (lo > hi) lo = 1, hi = 0;
+    arm->lo = (int32_t)lo;
+    arm->hi = (int32_t)hi;
+    return 1;
+}
+
+static inline void match_batch_scalar(const int32_t *subjects, size_t n, uint8_t *restrict arm_out,
+                                      const MatchBatchArm *restrict arms, int narms) {
+    for (size_t i = 0; i < n; i++) {
+        int32_t x = subjects[i];
+        int k = 0;
+        while (k < narms && ((x >= arms[k].lo && x <= arms[k].hi) == arms[k].invert)) k++;
+        arm_out[i] = (uint8_t)k;
+    }
+}
+
+#if MATCH_BATCH_X86
+__attribute__((target("avx2")))
+static inline void match_batch_avx2(const int32_t *subjects, size_t n, uint8_t *restrict arm_out,
+                                    const MatchBatchArm *restrict arms, int narms) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(subjects + i));
+        __m256i r = _mm256_set1_epi32(narms);
+        for (int k = narms - 1; k >= 0; k--) {
+            __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(arms[k].lo), x),
+                                              _mm256_cmpgt_epi32(x, _mm256_set1_epi32(arms[k].hi)));
+            __m256i hit = _mm256_xor_si256(outside, _mm256_set1_epi32(arms[k].invert - 1));
+            r = _mm256_blendv_epi8(r, _mm256_set1_epi32(k), hit);
+        }
+        __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+        _mm_storel_epi64((__m128i*)(arm_out + i), _mm_packus_epi16(words, words));
+    }
+    match_batch_scalar(subjects + i, n - i, arm_out + i, arms, narms);
+}
+
+__attribute__((target("sse4.2")))
+static inline void match_batch_sse42(const int32_t *subjects, size_t n, uint8_t *restrict arm_out,
+                                     const MatchBatchArm *restrict arms, int narms) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(subjects + i));
+        __m128i r = _mm_set1_epi32(narms);
+        for (int k = narms - 1; k >= 0; k--) {
+            __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(_mm_set1_epi32(arms[k].lo), x),
+                                           _mm_cmpgt_epi32(x, _mm_set1_epi32(arms[k].hi)));
+            __m128i hit = _mm_xor_si128(outside, _mm_set1_epi32(arms[k].invert - 1));
+            r = _mm_blendv_epi8(r, _mm_set1_epi32(k), hit);
+        }
+        __m128i words = _mm_packus_epi32(r, r);
+        int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+        __builtin_memcpy(arm_out + i, &bytes, 4);
+    }
+    match_batch_scalar(subjects + i, n - i, arm_out + i, arms, narms);
+}
+#endif
+
+static inline void match_batch_run(const int32_t *subjects, size_t n, uint8_t *arm_out,
+                                   const MatchPattern *patterns, int narms) {
+    MatchBatchArm arms[MATCH_BATCH_MAX_ARMS];
+    int vectorizable = 1;
+    for (int k = 0; k < narms; k++) vectorizable &= match_batch_arm(patterns[k], &arms[k]);
+
+    if (!vectorizable) {
+        for (size_t i = 0; i < n; i++) {
+            int k = 0;
+            while (k < narms && !evaluate_pattern((intptr_t)subjects[i], patterns[k])) k++;
+            arm_out[i] = (uint8_t)k;
+        }
+        return;
+    }
+#if MATCH_BATCH_X86
+    if (__builtin_cpu_supports("avx2")) {
+        match_batch_avx2(subjects, n, arm_out, arms, narms);
+        return;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        match_batch_sse42(subjects, n, arm_out, arms, narms);
+        return;
+    }
+#endif
+    match_batch_scalar(subjects, n, arm_out, arms, narms);
+}
+
+#define match_batch(subjects, n, arm_out, ...) \
+    match_batch_run((subjects), (n), (arm_out), \
+                    (const MatchPattern[]){ MATCH_BATCH_PATTERNS(COUNT_ARGS(__VA_ARGS__), __VA_ARGS__) }, \
+                    COUNT_ARGS(__VA_ARGS__))
+#define MATCH_BATCH_PATTERNS(N, ...) MATCH_BATCH_PATTERNS_(N, __VA_ARGS__)
+#define MATCH_BATCH_PATTERNS_(N, ...) MATCH_BATCH_PATTERNS_##N(__VA_ARGS__)
+
+#define MATCH_BATCH_PATTERNS_1(x1) _auto_pattern(x1)
+#define MATCH_BATCH_PATTERNS_2(x1, x2) _auto_pattern(x1), MATCH_BATCH_PATTERNS_1(x2)
+#define MATCH_BATCH_PATTERNS_3(x1, x2, x3) _auto_pattern(x1), MATCH_BATCH_PATTERNS_2(x2, x3)
+#define MATCH_BATCH_PATTERNS_4(x1, x2, x3, x4) _auto_pattern(x1), MATCH_BATCH_PATTERNS_3(x2, x3, x4)
+#define MATCH_BATCH_PATTERNS_5(x1, x2, x3, x4, x5) _auto_pattern(x1), MATCH_BATCH_PATTERNS_4(x2, x3, x4, x5)
+#define MATCH_BATCH_PATTERNS_6(x1, x2, x3, x4, x5, x6) _auto_pattern(x1), MATCH_BATCH_PATTERNS_5(x2, x3, x4, x5, x6)
+#define MATCH_BATCH_PATTERNS_7(x1, x2, x3, x4, x5, x6, x7) _auto_pattern(x1), MATCH_BATCH_PATTERNS_6(x2, x3, x4, x5, x6, x7)
+#define MATCH_BATCH_PATTERNS_8(x1, x2, x3, x4, x5, x6, x7, x8) _auto_pattern(x1), MATCH_BATCH_PATTERNS_7(x2, x3, x4, x5, x6, x7, x8)
+#define MATCH_BATCH_PATTERNS_9(x1, x2, x3, x4, x5, x6, x7, x8, x9) _auto_pattern(x1), MATCH_BATCH_PATTERNS_8(x2, x3, x4, x5, x6, x7, x8, x9)
+#define MATCH_BATCH_PATTERNS_10(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10) _auto_pattern(x1), MATCH_BATCH_PATTERNS_9(x2, x3, x4, x5, x6, x7, x8, x9, x10)
+
+// match_batch_double() is the same for double arrays (sensor readings,
+// latencies, scores). Each arm becomes a closed double interval plus two
+// flags: invert (ne()/fne()) and whether NaN matches (__, ne()/fne(), fnan).
+// Strict bounds are turned into closed ones by stepping to the adjacent
+// double, so the AVX kernel (4 lanes) is two ordered compares, an unordered
+// compare and a blend per arm, and NaN falls through every ordered pattern:
+//
+//   uint8_t band[N];
+//   match_batch_double(temps, N, band, fnan, flt(0.0), flt(40.0), __);
+
+typedef struct {
+    double lo;           // inclusive bounds; lo > hi never matches
+    double hi;
+    int32_t invert;      // match every ordered value outside [lo, hi]
+    int32_t nan;         // NaN matches this arm
+} MatchBatchDoubleArm;
+
+// Smallest double greater than v, for finite v or -inf
+static inline double match_next_up(double v) {
+    if (v == 0) return __DBL_DENORM_MIN__;
+    int64_t bits;
+    __builtin_memcpy(&bits, &v, sizeof bits);
+    bits += bits > 0 ? 1 : -1;
+    __builtin_memcpy(&v, &bits, sizeof v);
+    return v;
+}
+
+static inline double match_next_down(double v) {
+    return -match_next_up(-v);
+}
+
+static inline int match_batch_double_arm(MatchPattern pattern, MatchBatchDoubleArm *arm) {
+    double lo = -__builtin_inf(), hi = __builtin_inf();
+    int lo_open = 0, hi_open = 0;
+    double v = MATCH_PAT_IS_FLOAT(pattern.kind) ? pattern.flo : (double)pattern.lo;
+    double w = MATCH_PAT_IS_FLOAT(pattern.kind) ? pattern.fhi : (double)pattern.hi;
+    arm->invert = 0;
+    arm->nan = 0;
+    switch (pattern.kind) {
+        case MATCH_PAT_ANY: arm->nan = 1; break;
+        case MATCH_PAT_EQ: case MATCH_PAT_FEQ: lo = hi = v; break;
+        case MATCH_PAT_NE: case MATCH_PAT_FNE: lo = hi = v; arm->invert = arm->nan = 1; break;
+        case MATCH_PAT_GT: case MATCH_PAT_FGT: lo = v; lo_open = 1; break;
+        case MATCH_PAT_GE: case MATCH_PAT_FGE: lo = v; break;
+        case MATCH_PAT_LT: case MATCH_PAT_FLT: hi = v; hi_open = 1; break;
+        case MATCH_PAT_LE: case MATCH_PAT_FLE: hi = v; break;
+        case MATCH_PAT_RANGE: case MATCH_PAT_FRANGE: lo = v; hi = w; lo_open = hi_open = 1; break;
+        case MATCH_PAT_BETWEEN: case MATCH_PAT_FBETWEEN: lo = v; hi = w; break;
+        case MATCH_PAT_URANGE:
+            lo = (double)(uint64_t)pattern.lo; hi = (double)(uint64_t)pattern.hi;
+            lo_open = hi_open = 1;
+            break;
+        case MATCH_PAT_UBETWEEN: lo = (double)(uint64_t)pattern.lo; hi = (double)(uint64_t)pattern.hi; break;
+        case MATCH_PAT_FNAN: lo = 1; hi = 0; arm->nan = 1; break;
+        case MATCH_PAT_VARIANT:
+        case MATCH_PAT_STR: lo = 1; hi = 0; break;
+        case MATCH_PAT_MASK:
+        case MATCH_PAT_SET32:
+        case MATCH_PAT_SET: return 0;
+    }
+    // A NaN bound matches no ordered value (so ne(NaN) matches everything)
+    if (lo != lo || hi != hi) lo = 1, hi = 0;
+    if (lo_open) lo = lo == __builtin_inf() ? __builtin_inf() : match_next_up(lo);
+    if (hi_open) hi = hi == -__builtin_inf() ? -__builtin_inf() : match_next_down(hi);
+    if (lo_open && lo == __builtin_inf()) lo = 1, hi = 0;
+    if (hi_open && hi == -__builtin_inf()) lo = 1, hi = 0;
+    arm->lo = lo;
+    arm->hi = hi;
+    return 1;
+}
+
+static inline void match_batch_double_scalar(const double *subjects, size_t n, uint8_t *restrict arm_out,
+                                             const MatchBatchDoubleArm *restrict arms, int narms) {
+    for (size_t i = 0; i < n; i++) {
+        double x = subjects[i];
+        int k = 0;
+        while (k < narms && !(((x >= arms[k].lo && x <= arms[k].hi) != arms[k].invert && x == x) ||
+                              (arms[k].nan && x != x))) {
+            k++;
+        }
+        arm_out[i] = (uint8_t)k;
+    }
+}
+
+#if MATCH_BATCH_X86
+__attribute__((target("avx2")))
+static inline void match_batch_double_avx2(const double *subjects, size_t n, uint8_t *restrict arm_out,
+                                           const MatchBatchDoubleArm *restrict arms, int narms) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d x = _mm256_loadu_pd(subjects + i);
+        __m256d unordered = _mm256_cmp_pd(x, x, _CMP_UNORD_Q);
+        __m256i r = _mm256_set1_epi64x(narms);
+        for (int k = narms - 1; k >= 0; k--) {
+            __m256d inside = _mm256_and_pd(_mm256_cmp_pd(x, _mm256_set1_pd(arms[k].lo), _CMP_GE_OQ),
+                                           _mm256_cmp_pd(x, _mm256_set1_pd(arms[k].hi), _CMP_LE_OQ));
+            __m256d flip = _mm256_andnot_pd(unordered, _mm256_castsi256_pd(_mm256_set1_epi64x(-(int64_t)arms[k].invert)));
+            __m256d nan = _mm256_and_pd(unordered, _mm256_castsi256_pd(_mm256_set1_epi64x(-(int64_t)arms[k].nan)));
+            __m256d hit = _mm256_or_pd(_mm256_xor_pd(inside, flip), nan);
+            r = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(r),
+                                                     _mm256_castsi256_pd(_mm256_set1_epi64x(k)), hit));
+        }
+        // Gather the low byte of each 64-bit lane
+        __m256i bytes = _mm256_shuffle_epi8(r, _mm256_setr_epi8(0, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                                0, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+        uint16_t lo = (uint16_t)_mm_extract_epi16(_mm256_castsi256_si128(bytes), 0);
+        uint16_t hi = (uint16_t)_mm_extract_epi16(_mm256_extracti128_si256(bytes, 1), 0);
+        uint32_t packed = (uint32_t)lo | ((uint32_t)hi << 16);
+        __builtin_memcpy(arm_out + i, &packed, 4);
+    }
+    match_batch_double_scalar(subjects + i, n - i, arm_out + i, arms, narms);
+}
+#endif
+
+static inline void match_batch_double_run(const double *subjects, size_t n, uint8_t *arm_out,
+                                          const MatchPattern *patterns, int narms) {
+    MatchBatchDoubleArm arms[MATCH_BATCH_MAX_ARMS];
+    int vectorizable = 1;
+    for (int k = 0; k < narms; k++) vectorizable &= match_batch_double_arm(patterns[k], &arms[k]);
+
+    if (!vectorizable) {
+        for (size_t i = 0; i < n; i++) {
+            int k = 0;
+            while (k < narms && !evaluate_float_pattern(subjects[i], patterns[k])) k++;
+            arm_out[i] = (uint8_t)k;
+        }
+        return;
+    }
+#if MATCH_BATCH_X86
+    if (__builtin_cpu_supports("avx2")) {
+        match_batch_double_avx2(subjects, n, arm_out, arms, narms);
+        return;
+    }
+#endif
+    match_batch_double_scalar(subjects, n, arm_out, arms, narms);
+}
+
+#define match_batch_double(subjects, n, arm_out, ...) \
+    match_batch_double_run((subjects), (n), (arm_out), \
+                           (const MatchPattern[]){ MATCH_BATCH_PATTERNS(COUNT_ARGS(__VA_ARGS__), __VA_ARGS__) }, \
+                           COUNT_ARGS(__VA_ARGS__))
+
+// ============================================================================
+// Range Ladders: match_ranges(x, arms...) and match_bucket(x, thresholds, n)
+// ============================================================================
+
+// A ladder such as is(ge(90)) ? 'A' : is(ge(80)) ? 'B' : ... is a chain of
+// data-dependent branches, which mispredict constantly on random input. When
+// every arm's set contains the previous one (descending ge()/gt() thresholds,
+// ascending lt()/le() thresholds, optionally ending in __), the arms that fail
+// form a prefix, so the first matching arm is simply the number of failing
+// arms. match_ranges() computes that sum of compares without branches:
+//
+//   char grade = "ABCDF"[match_ranges(score, ge(90), ge(80), ge(70), ge(60))];
+//
+// Double subjects work the same way with fge()/flt() arms (NaN matches no
+// ordered arm). Like match_batch(), the result is the arm count when nothing
+// matches. For arms that are not nested the result is meaningless; use let()
+// instead.
+#define match_ranges(x, ...) \
+    ({ __auto_type __ranges_x = (x); \
+       (int)(MATCH_RANGES_MISSES(COUNT_ARGS(__VA_ARGS__), __VA_ARGS__)); })
+#define MATCH_RANGES_MISSES(N, ...) MATCH_RANGES_MISSES_(N, __VA_ARGS__)
+#define MATCH_RANGES_MISSES_(N, ...) MATCH_RANGES_MISSES_##N(__VA_ARGS__)
+
+#define MATCH_RANGES_MISS(x) \
+    (!evaluate_pattern_typed(MATCH_MODE_STRICT, (void*)0, MATCH_AS_INTPTR(__ranges_x), MATCH_IS_FLOAT(__ranges_x), \
+                             MATCH_AS_DOUBLE(__ranges_x), str_view(0, 0), _auto_pattern(x)))
+#define MATCH_RANGES_MISSES_1(x1) MATCH_RANGES_MISS(x1)
+#define MATCH_RANGES_MISSES_2(x1, x2) MATCH_RANGES_MISS(x1) + MATCH_RANGES_MISSES_1(x2)
+#define MATCH_RANGES_MISSES_3(x1, x2, x3) MATCH_RANGES_MISS(x1) + MATCH_RANGES_MISSES_2(x2, x3)
+#define MATCH_RANGES_MISSES_4(x1, x2, x3, x4) MATCH_RANGES_MISS(x1) + MATCH_RANGES_MISSES_3(x2, x3, x4)
+#define MATCH_RANGES_MISSES_5(x1, x2, x3, x4, x5) MATCH_RANGES_MISS(x1) + MATCH_RANGES_MISSES_4(x2, x3, x4, x5)
+#define MATCH_RANGES_MISSES_6(x1, x2, x3, x4, x5, x6) MATCH_RANGES_MISS(x1) + MATCH_RANGES_MISSES_5(x2, x3, x4, x5, x6)
+#define MATCH_RANGES_MISSES_7(x1, x2, x3, x4, x5, x6, x7) MATCH_RANGES_MISS(x1) + MATCH_RANGES_MISSES_6(x2, x3, x4, x5, x6, x7)
+#define MATCH_RANGES_MISSES_8(x1, x2, x3, x4, x5, x6, x7, x8) MATCH_RANGES_MISS(x1) + MATCH_RANGES_MISSES_7(x2, x3, x4, x5, x6, x7, x8)
+#define MATCH_RANGES_MISSES_9(x1, x2, x3, x4, x5, x6, x7, x8, x9) MATCH_RANGES_MISS(x1) + MATCH_RANGES_MISSES_8(x2, x3, x4, x5, x6, x7, x8, x9)
+#define MATCH_RANGES_MISSES_10(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10) MATCH_RANGES_MISS(x1) + MATCH_RANGES_MISSES_9(x2, x3, x4, x5, x6, x7, x8, x9, x10)
+
+// For longer ladders kept in a table: the number of ascending thresholds that
+// are <= x, found by a branchless lower-bound search (every step is a
+// conditional move, and the trip count depends only on n):
+//
+//   static const int64_t latency_us[] = { 100, 1000, 10000, 100000, 1000000 };
+//   size_t bucket = match_bucket(sample, latency_us, 5);   // 0..5
+static inline size_t match_bucket(int64_t x, const int64_t *thresholds, size_t n) {
+    if (n == 0) return 0;
+    const int64_t *base = thresholds;
+    while (n > 1) {
+        size_t half = n / 2;
+        base = (base[half] <= x) ? base + half : base;
+        n -= half;
+    }
+    return (size_t)(base - thresholds) + (*base <= x);
+}
+
 // ============================================================================
 // OPTION TYPES - Nullable Value Handling
 // ============================================================================
@@ -930,11 +2365,8 @@ static inline int evaluate_pattern_enhanced(void* subject, intptr_t actual, void
 // OPTION TYPES IMPLEMENTATION
 // ============================================================================
 
-// Common option tags
-typedef enum {
-    Option_Some = 1,
-    Option_None = 2
-} OptionTag;
+// Option tags (OptionTag) are declared with the Result tags at the top of
+// this file, because variant() needs Option_None for niche options
 
 // ============================================================================
 // Macro to create Option types for any type
@@ -947,6 +2379,7 @@ typedef enum {
         union { \
             TYPE Some; \
             char _none; /* Placeholder for None variant */ \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
     } Option_##TYPE; \
     \
@@ -956,6 +2389,13 @@ typedef enum {
     \
     static inline Option_##TYPE none_##TYPE(void) { \
         return (Option_##TYPE){Option_None, 0, ._none = 0}; \
+    } \
+    \
+    /* Marks *out Some and returns its payload slot, to be filled in place */ \
+    static inline TYPE* some_##TYPE##_into(Option_##TYPE* out) { \
+        out->tag = Option_Some; \
+        out->_padding = 0; \
+        return &out->Some; \
     }
 
 // ============================================================================
@@ -969,6 +2409,7 @@ typedef enum {
         union { \
             TYPE* Some; \
             char _none; /* Placeholder for None variant */ \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
     } Option_##SUFFIX; \
     \
@@ -980,68 +2421,175 @@ typedef enum {
         return (Option_##SUFFIX){Option_None, 0, ._none = 0}; \
     }
 
+// ============================================================================
+// Niche-optimized options: no stored tag, None is a sentinel payload value
+// ============================================================================
+
+// CreateOptionNiche(TYPE, SENTINEL) - Option_TYPE for an integer or enum type
+// where SENTINEL can never be a real value (INT_MIN, SIZE_MAX, -1 for a file
+// descriptor, an enum's "invalid" member). sizeof(Option_TYPE) ==
+// sizeof(TYPE), and is_some() is a single compare against the sentinel:
+//   CreateOptionNiche(Fd, -1)
+//   Option_Fd fd = open_config();     // one int, returned in eax
+//   if (is_some(&fd)) read_config(fd.Some);
+// Same API as CreateOption (some_/none_ constructors, .Some, helper macros,
+// variant(Option_Some)); some_TYPE(SENTINEL) is None.
+#define CreateOptionNiche(TYPE, SENTINEL) \
+    _Static_assert((TYPE)1 / 2 == 0, "CreateOptionNiche needs an integer or enum type"); \
+    MATCH_NICHE_OPTION(TYPE, TYPE, SENTINEL, __COUNTER__)
+
+// CreateOptionPtrNiche(TYPE, SUFFIX) - the same for TYPE*, with NULL as None.
+// The option is one machine word and travels in a single register. A
+// present-but-NULL value cannot be represented; use CreateOptionPtr for that.
+#define CreateOptionPtrNiche(TYPE, SUFFIX) MATCH_NICHE_OPTION(TYPE*, SUFFIX, 0, __COUNTER__)
+
+// slot: this type's layout slot, see MATCH_SLOTS
+#define MATCH_NICHE_OPTION(TYPE, SUFFIX, SENTINEL, slot) \
+    typedef struct MATCH_SLOT_STRUCT(slot) { \
+        MATCH_NICHE_FIELDS((uint64_t)(SENTINEL) & (~0ULL >> (64 - 8 * sizeof(TYPE)))) \
+        union { \
+            TYPE Some; \
+            MATCH_NICHE_TAG(sizeof(TYPE)) tag; /* the payload's bits, see MATCH_IS_NICHE */ \
+            char _payload; /* names the payload offset, see it() */ \
+        }; \
+    } Option_##SUFFIX; \
+    \
+    static inline Option_##SUFFIX some_##SUFFIX(TYPE val) { \
+        return (Option_##SUFFIX){.Some = val}; \
+    } \
+    \
+    static inline Option_##SUFFIX none_##SUFFIX(void) { \
+        return (Option_##SUFFIX){.Some = (SENTINEL)}; \
+    } \
+    MATCH_SLOT_REGISTER(slot, Option_##SUFFIX)
+
+// Niche tag wrapper for a payload of the given size
+#define MATCH_NICHE_TAG(size) \
+    __typeof__(__builtin_choose_expr((size) == 1, (MatchNiche8){0}, \
+               __builtin_choose_expr((size) == 2, (MatchNiche16){0}, \
+               __builtin_choose_expr((size) == 4, (MatchNiche32){0}, (MatchNiche64){0}))))
+
 // ============================================================================
 // Predefined common Option types
 // ============================================================================
 
-// Basic types
+// Basic types. Define MATCH_NICHE_OPTIONS before including this header to
+// make the integer ones niche-optimized (INT_MIN, LONG_MIN, SHRT_MIN and
+// SIZE_MAX become None); every translation unit sharing these types must
+// agree on the setting.
+#ifdef MATCH_NICHE_OPTIONS
+CreateOptionNiche(int, INT_MIN)
+CreateOptionNiche(long, LONG_MIN)
+CreateOptionNiche(short, SHRT_MIN)
+CreateOptionNiche(size_t, SIZE_MAX)
+#else
 CreateOption(int)
-CreateOption(float)
-CreateOption(double)
 CreateOption(long)
 CreateOption(short)
 CreateOption(size_t)
+#endif
+CreateOption(float)
+CreateOption(double)
 
-// Pointer types with clean names
-CreateOptionPtr(char, char_ptr)
-CreateOptionPtr(void, void_ptr)
-CreateOptionPtr(int, int_ptr)
-CreateOptionPtr(float, float_ptr)
-CreateOptionPtr(double, double_ptr)
-CreateOptionPtr(long, long_ptr)
-CreateOptionPtr(short, short_ptr)
-CreateOptionPtr(size_t, size_t_ptr)
+// Pointer types with clean names (niche-optimized: one word, NULL is None)
+CreateOptionPtrNiche(char, char_ptr)
+CreateOptionPtrNiche(void, void_ptr)
+CreateOptionPtrNiche(int, int_ptr)
+CreateOptionPtrNiche(float, float_ptr)
+CreateOptionPtrNiche(double, double_ptr)
+CreateOptionPtrNiche(long, long_ptr)
+CreateOptionPtrNiche(short, short_ptr)
+CreateOptionPtrNiche(size_t, size_t_ptr)
 
 // ============================================================================
 // Generic helper macros for working with any Option type
 // ============================================================================
 
-#define is_some(option_ptr) ((option_ptr)->tag == Option_Some)
-#define is_none(option_ptr) ((option_ptr)->tag == Option_None)
-
-#define unwrap_option_or(option_ptr, default_val) \
-    (is_some(option_ptr) ? (option_ptr)->Some : (default_val))
-
-#define unwrap_option_or_else(option_ptr, func) \
-    (is_some(option_ptr) ? (option_ptr)->Some : func())
+// Work on tagged and niche options alike; on a niche option each is a
+// single compare of the payload against its sentinel
+#define is_some(option_ptr) MATCH_OPTION_IS(option_ptr, Option_Some)
+#define is_none(option_ptr) MATCH_OPTION_IS(option_ptr, Option_None)
+
+// Like the Result helpers, these evaluate option_ptr once and the default
+// only when the option is None
+#define unwrap_option_or(option_ptr, default_val) ({ \
+    __auto_type __match_o = (option_ptr); \
+    is_some(__match_o) ? __match_o->Some : (default_val); \
+})
+
+#define unwrap_option_or_else(option_ptr, func) ({ \
+    __auto_type __match_o = (option_ptr); \
+    is_some(__match_o) ? __match_o->Some : func(); \
+})
+
+// By-reference access, as unwrap_ref()/as_ref() for Results
+#define unwrap_option_ref(option_ptr, default_ptr) ({ \
+    __auto_type __match_o = (option_ptr); \
+    is_some(__match_o) ? &__match_o->Some : (default_ptr); \
+})
+
+#define option_as_ref(option_ptr) ({ \
+    __auto_type __match_o = (option_ptr); \
+    is_some(__match_o) ? &__match_o->Some : NULL; \
+})
+
+// SOME_INIT(option_ptr, ...) - make *option_ptr Some with the payload built in
+// place, as OK_INIT() for Results. On a niche option the payload is the
+// state, so initializing it to the sentinel leaves the option None.
+#define SOME_INIT(option_ptr, ...) ({ \
+    __auto_type __match_out = (option_ptr); \
+    __match_out->Some = (__typeof__(__match_out->Some)){ __VA_ARGS__ }; \
+    if (!MATCH_IS_NICHE(__match_out->tag)) \
+        match_store_tag(&__match_out->tag, sizeof(__match_out->tag), Option_Some); \
+    (void)0; \
+})
 
 // ============================================================================
 // Chaining operations for Options
 // ============================================================================
 
-#define OPTION_MAP(option_ptr, func, option_type) \
-    (is_some(option_ptr) ? some_##option_type(func((option_ptr)->Some)) : none_##option_type())
-
-#define OPTION_AND_THEN(option_ptr, func) \
-    (is_some(option_ptr) ? func((option_ptr)->Some) : *option_ptr)
-
-#define OPTION_FILTER(option_ptr, predicate) \
-    (is_some(option_ptr) && predicate((option_ptr)->Some) ? *option_ptr : \
-     (typeof(*option_ptr)){Option_None, 0, ._none = 0})
+#define OPTION_MAP(option_ptr, func, option_type) ({ \
+    __auto_type __match_o = (option_ptr); \
+    is_some(__match_o) ? some_##option_type(func(__match_o->Some)) : none_##option_type(); \
+})
+
+#define OPTION_AND_THEN(option_ptr, func) ({ \
+    __auto_type __match_o = (option_ptr); \
+    is_some(__match_o) ? func(__match_o->Some) : *__match_o; \
+})
+
+#define OPTION_FILTER(option_ptr, predicate) ({ \
+    __auto_type __match_o = (option_ptr); \
+    is_some(__match_o) && predicate(__match_o->Some) ? *__match_o : \
+        MATCH_OPTION_NONE(__typeof__(*__match_o)); \
+})
+
+// None of any Option type: tag Option_None, or the sentinel for a niche
+#define MATCH_OPTION_NONE(type) \
+    ({ type __none; \
+       __builtin_memset(&__none, 0, sizeof __none); \
+       match_store_tag(&__none.tag, sizeof(__none.tag), \
+                       MATCH_IS_NICHE(__none.tag) ? MATCH_NICHE_BITS(MATCH_NICHE_VIEW(&__none)) \
+                                                  : (uint64_t)Option_None); \
+       __none; })
 
 // ============================================================================
 // Option conversion utilities
 // ============================================================================
 
 // Convert Option to Result
-#define OPTION_TO_RESULT(option_ptr, error_msg, result_type) \
-    (is_some(option_ptr) ? ok_##result_type((option_ptr)->Some) : \
-                           err_##result_type(error_msg))
+#define OPTION_TO_RESULT(option_ptr, error_msg, result_type) ({ \
+    __auto_type __match_o = (option_ptr); \
+    is_some(__match_o) ? ok_##result_type(__match_o->Some) : \
+                         err_##result_type(error_msg); \
+})
 
 // Convert Result to Option (discards error information)
-#define RESULT_TO_OPTION(result_ptr, option_type) \
-    (is_ok(result_ptr) ? some_##option_type((result_ptr)->Ok) : \
-                         none_##option_type())
+#define RESULT_TO_OPTION(result_ptr, option_type) ({ \
+    __auto_type __match_r = (result_ptr); \
+    is_ok(__match_r) ? some_##option_type(__match_r->Ok) : \
+                       none_##option_type(); \
+})
 
 // ============================================================================
 // Tag Union Generator - All-in-one variadic approach
@@ -1081,7 +2629,42 @@ CreateOptionPtr(size_t, size_t_ptr)
 
 // Main variadic tag_union macro using argument counting
 #define tag_union(union_name, ...) \
-    TAG_UNION_DISPATCH(TAG_UNION_COUNT(__VA_ARGS__), union_name, __VA_ARGS__)
+    TAG_UNION_DISPATCH(TAG_UNION_COUNT(__VA_ARGS__), CLASSIC, ~, union_name, __VA_ARGS__)
+
+// Compact layouts for large arrays - same variants, constructors and enum
+// constants, but the tag is the smallest unsigned type that holds the variant
+// count (uint8_t up to 255 variants) and sits after the payload:
+//   tag_union_compact  - natural alignment, so payload access stays aligned;
+//                        int/float variants take 8 bytes instead of 16
+//   tag_union_packed   - no padding at all (e.g. 9 bytes for a double
+//                        payload); the payload may be unaligned, so read it
+//                        through the generated type rather than a pointer
+// Both claim a layout slot (see MATCH_SLOTS), so when(union_name_Tag) on
+// &value reads the real tag in auto mode as well as through variant(tag).
+#define tag_union_compact(union_name, ...) \
+    TAG_UNION_DISPATCH(TAG_UNION_COUNT(__VA_ARGS__), COMPACT, __COUNTER__, union_name, __VA_ARGS__)
+#define tag_union_packed(union_name, ...) \
+    TAG_UNION_DISPATCH(TAG_UNION_COUNT(__VA_ARGS__), PACKED, __COUNTER__, union_name, __VA_ARGS__)
+
+#define MATCH_COMPACT_TAG(n) \
+    __typeof__(__builtin_choose_expr((n) <= UINT8_MAX, (uint8_t)0, (uint16_t)0))
+
+// Layout pieces: attributes, fields before the union, fields after it
+#define TAG_UNION_ATTR_CLASSIC
+#define TAG_UNION_SLOT_CLASSIC(slot)
+#define TAG_UNION_REGISTER_CLASSIC(slot, union_name)
+#define TAG_UNION_HEAD_CLASSIC uint32_t tag; uint32_t _padding;
+#define TAG_UNION_TAIL_CLASSIC(n)
+#define TAG_UNION_ATTR_COMPACT
+#define TAG_UNION_SLOT_COMPACT(slot) MATCH_SLOT_STRUCT(slot)
+#define TAG_UNION_REGISTER_COMPACT(slot, union_name) MATCH_SLOT_REGISTER(slot, union_name)
+#define TAG_UNION_HEAD_COMPACT
+#define TAG_UNION_TAIL_COMPACT(n) MATCH_COMPACT_TAG(n) tag;
+#define TAG_UNION_ATTR_PACKED __attribute__((packed))
+#define TAG_UNION_SLOT_PACKED(slot) MATCH_SLOT_STRUCT(slot)
+#define TAG_UNION_REGISTER_PACKED(slot, union_name) MATCH_SLOT_REGISTER(slot, union_name)
+#define TAG_UNION_HEAD_PACKED
+#define TAG_UNION_TAIL_PACKED(n) MATCH_COMPACT_TAG(n) tag;
 
 // Argument counting macro (counts pairs of type,name after union_name)
 #define TAG_UNION_COUNT(...) \
@@ -1090,68 +2673,71 @@ CreateOptionPtr(size_t, size_t_ptr)
 #define TAG_UNION_COUNT_IMPL(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, N, ...) N
 
 // Dispatch macro
-#define TAG_UNION_DISPATCH(N, union_name, ...) \
-    TAG_UNION_DISPATCH_(N, union_name, __VA_ARGS__)
+#define TAG_UNION_DISPATCH(N, layout, slot, union_name, ...) \
+    TAG_UNION_DISPATCH_(N, layout, slot, union_name, __VA_ARGS__)
 
-#define TAG_UNION_DISPATCH_(N, union_name, ...) \
-    TAG_UNION_##N(union_name, __VA_ARGS__)
+#define TAG_UNION_DISPATCH_(N, layout, slot, union_name, ...) \
+    TAG_UNION_##N(layout, slot, union_name, __VA_ARGS__) \
+    TAG_UNION_REGISTER_##layout(slot, union_name)
 
 // Implementation for 2 variants (4 args after union_name)
-#define TAG_UNION_4(union_name, type1, name1, type2, name2) \
+#define TAG_UNION_4(layout, slot, union_name, type1, name1, type2, name2) \
     enum { \
         union_name##_##name1 = 1, \
         union_name##_##name2 = 2 \
     }; \
     \
-    typedef struct { \
-        uint32_t tag; \
-        uint32_t _padding; \
+    typedef struct TAG_UNION_ATTR_##layout TAG_UNION_SLOT_##layout(slot) { \
+        TAG_UNION_HEAD_##layout \
         union { \
             type1 name1; \
             type2 name2; \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
+        TAG_UNION_TAIL_##layout(2) \
     } union_name; \
     \
     static inline union_name new_##union_name##_##name1(type1 val) { \
-        return (union_name){union_name##_##name1, 0, .name1 = val}; \
+        return (union_name){.tag = union_name##_##name1, .name1 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name2(type2 val) { \
-        return (union_name){union_name##_##name2, 0, .name2 = val}; \
+        return (union_name){.tag = union_name##_##name2, .name2 = val}; \
     }
 
 // Implementation for 3 variants (6 args after union_name)
-#define TAG_UNION_6(union_name, type1, name1, type2, name2, type3, name3) \
+#define TAG_UNION_6(layout, slot, union_name, type1, name1, type2, name2, type3, name3) \
     enum { \
         union_name##_##name1 = 1, \
         union_name##_##name2 = 2, \
         union_name##_##name3 = 3 \
     }; \
     \
-    typedef struct { \
-        uint32_t tag; \
-        uint32_t _padding; \
+    typedef struct TAG_UNION_ATTR_##layout TAG_UNION_SLOT_##layout(slot) { \
+        TAG_UNION_HEAD_##layout \
         union { \
             type1 name1; \
             type2 name2; \
             type3 name3; \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
+        TAG_UNION_TAIL_##layout(3) \
     } union_name; \
     \
     static inline union_name new_##union_name##_##name1(type1 val) { \
-        return (union_name){union_name##_##name1, 0, .name1 = val}; \
+        return (union_name){.tag = union_name##_##name1, .name1 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name2(type2 val) { \
-        return (union_name){union_name##_##name2, 0, .name2 = val}; \
+        return (union_name){.tag = union_name##_##name2, .name2 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name3(type3 val) { \
-        return (union_name){union_name##_##name3, 0, .name3 = val}; \
+        return (union_name){.tag = union_name##_##name3, .name3 = val}; \
     }
 
 // Implementation for 4 variants (8 args after union_name)
-#define TAG_UNION_8(union_name, type1, name1, type2, name2, type3, name3, type4, name4) \
+#define TAG_UNION_8(layout, slot, union_name, type1, name1, type2, name2, type3, name3, type4, name4) \
     enum { \
         union_name##_##name1 = 1, \
         union_name##_##name2 = 2, \
@@ -1159,35 +2745,36 @@ CreateOptionPtr(size_t, size_t_ptr)
         union_name##_##name4 = 4 \
     }; \
     \
-    typedef struct { \
-        uint32_t tag; \
-        uint32_t _padding; \
+    typedef struct TAG_UNION_ATTR_##layout TAG_UNION_SLOT_##layout(slot) { \
+        TAG_UNION_HEAD_##layout \
         union { \
             type1 name1; \
             type2 name2; \
             type3 name3; \
             type4 name4; \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
+        TAG_UNION_TAIL_##layout(4) \
     } union_name; \
     \
     static inline union_name new_##union_name##_##name1(type1 val) { \
-        return (union_name){union_name##_##name1, 0, .name1 = val}; \
+        return (union_name){.tag = union_name##_##name1, .name1 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name2(type2 val) { \
-        return (union_name){union_name##_##name2, 0, .name2 = val}; \
+        return (union_name){.tag = union_name##_##name2, .name2 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name3(type3 val) { \
-        return (union_name){union_name##_##name3, 0, .name3 = val}; \
+        return (union_name){.tag = union_name##_##name3, .name3 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name4(type4 val) { \
-        return (union_name){union_name##_##name4, 0, .name4 = val}; \
+        return (union_name){.tag = union_name##_##name4, .name4 = val}; \
     }
 
 // Implementation for 5 variants (10 args after union_name)
-#define TAG_UNION_10(union_name, type1, name1, type2, name2, type3, name3, type4, name4, type5, name5) \
+#define TAG_UNION_10(layout, slot, union_name, type1, name1, type2, name2, type3, name3, type4, name4, type5, name5) \
     enum { \
         union_name##_##name1 = 1, \
         union_name##_##name2 = 2, \
@@ -1196,40 +2783,41 @@ CreateOptionPtr(size_t, size_t_ptr)
         union_name##_##name5 = 5 \
     }; \
     \
-    typedef struct { \
-        uint32_t tag; \
-        uint32_t _padding; \
+    typedef struct TAG_UNION_ATTR_##layout TAG_UNION_SLOT_##layout(slot) { \
+        TAG_UNION_HEAD_##layout \
         union { \
             type1 name1; \
             type2 name2; \
             type3 name3; \
             type4 name4; \
             type5 name5; \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
+        TAG_UNION_TAIL_##layout(5) \
     } union_name; \
     \
     static inline union_name new_##union_name##_##name1(type1 val) { \
-        return (union_name){union_name##_##name1, 0, .name1 = val}; \
+        return (union_name){.tag = union_name##_##name1, .name1 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name2(type2 val) { \
-        return (union_name){union_name##_##name2, 0, .name2 = val}; \
+        return (union_name){.tag = union_name##_##name2, .name2 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name3(type3 val) { \
-        return (union_name){union_name##_##name3, 0, .name3 = val}; \
+        return (union_name){.tag = union_name##_##name3, .name3 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name4(type4 val) { \
-        return (union_name){union_name##_##name4, 0, .name4 = val}; \
+        return (union_name){.tag = union_name##_##name4, .name4 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name5(type5 val) { \
-        return (union_name){union_name##_##name5, 0, .name5 = val}; \
+        return (union_name){.tag = union_name##_##name5, .name5 = val}; \
     }
 
 // Implementation for 6 variants (12 args after union_name)
-#define TAG_UNION_12(union_name, type1, name1, type2, name2, type3, name3, type4, name4, type5, name5, type6, name6) \
+#define TAG_UNION_12(layout, slot, union_name, type1, name1, type2, name2, type3, name3, type4, name4, type5, name5, type6, name6) \
     enum { \
         union_name##_##name1 = 1, \
         union_name##_##name2 = 2, \
@@ -1239,9 +2827,8 @@ CreateOptionPtr(size_t, size_t_ptr)
         union_name##_##name6 = 6 \
     }; \
     \
-    typedef struct { \
-        uint32_t tag; \
-        uint32_t _padding; \
+    typedef struct TAG_UNION_ATTR_##layout TAG_UNION_SLOT_##layout(slot) { \
+        TAG_UNION_HEAD_##layout \
         union { \
             type1 name1; \
             type2 name2; \
@@ -1249,35 +2836,37 @@ CreateOptionPtr(size_t, size_t_ptr)
             type4 name4; \
             type5 name5; \
             type6 name6; \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
+        TAG_UNION_TAIL_##layout(6) \
     } union_name; \
     \
     static inline union_name new_##union_name##_##name1(type1 val) { \
-        return (union_name){union_name##_##name1, 0, .name1 = val}; \
+        return (union_name){.tag = union_name##_##name1, .name1 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name2(type2 val) { \
-        return (union_name){union_name##_##name2, 0, .name2 = val}; \
+        return (union_name){.tag = union_name##_##name2, .name2 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name3(type3 val) { \
-        return (union_name){union_name##_##name3, 0, .name3 = val}; \
+        return (union_name){.tag = union_name##_##name3, .name3 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name4(type4 val) { \
-        return (union_name){union_name##_##name4, 0, .name4 = val}; \
+        return (union_name){.tag = union_name##_##name4, .name4 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name5(type5 val) { \
-        return (union_name){union_name##_##name5, 0, .name5 = val}; \
+        return (union_name){.tag = union_name##_##name5, .name5 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name6(type6 val) { \
-        return (union_name){union_name##_##name6, 0, .name6 = val}; \
+        return (union_name){.tag = union_name##_##name6, .name6 = val}; \
     }
 
 // Implementation for 7 variants (14 args after union_name)
-#define TAG_UNION_14(union_name, type1, name1, type2, name2, type3, name3, type4, name4, type5, name5, type6, name6, type7, name7) \
+#define TAG_UNION_14(layout, slot, union_name, type1, name1, type2, name2, type3, name3, type4, name4, type5, name5, type6, name6, type7, name7) \
     enum { \
         union_name##_##name1 = 1, \
         union_name##_##name2 = 2, \
@@ -1288,9 +2877,8 @@ CreateOptionPtr(size_t, size_t_ptr)
         union_name##_##name7 = 7 \
     }; \
     \
-    typedef struct { \
-        uint32_t tag; \
-        uint32_t _padding; \
+    typedef struct TAG_UNION_ATTR_##layout TAG_UNION_SLOT_##layout(slot) { \
+        TAG_UNION_HEAD_##layout \
         union { \
             type1 name1; \
             type2 name2; \
@@ -1299,39 +2887,41 @@ CreateOptionPtr(size_t, size_t_ptr)
             type5 name5; \
             type6 name6; \
             type7 name7; \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
+        TAG_UNION_TAIL_##layout(7) \
     } union_name; \
     \
     static inline union_name new_##union_name##_##name1(type1 val) { \
-        return (union_name){union_name##_##name1, 0, .name1 = val}; \
+        return (union_name){.tag = union_name##_##name1, .name1 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name2(type2 val) { \
-        return (union_name){union_name##_##name2, 0, .name2 = val}; \
+        return (union_name){.tag = union_name##_##name2, .name2 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name3(type3 val) { \
-        return (union_name){union_name##_##name3, 0, .name3 = val}; \
+        return (union_name){.tag = union_name##_##name3, .name3 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name4(type4 val) { \
-        return (union_name){union_name##_##name4, 0, .name4 = val}; \
+        return (union_name){.tag = union_name##_##name4, .name4 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name5(type5 val) { \
-        return (union_name){union_name##_##name5, 0, .name5 = val}; \
+        return (union_name){.tag = union_name##_##name5, .name5 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name6(type6 val) { \
-        return (union_name){union_name##_##name6, 0, .name6 = val}; \
+        return (union_name){.tag = union_name##_##name6, .name6 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name7(type7 val) { \
-        return (union_name){union_name##_##name7, 0, .name7 = val}; \
+        return (union_name){.tag = union_name##_##name7, .name7 = val}; \
     }
 
 // Implementation for 8 variants (16 args after union_name)
-#define TAG_UNION_16(union_name, type1, name1, type2, name2, type3, name3, type4, name4, type5, name5, type6, name6, type7, name7, type8, name8) \
+#define TAG_UNION_16(layout, slot, union_name, type1, name1, type2, name2, type3, name3, type4, name4, type5, name5, type6, name6, type7, name7, type8, name8) \
     enum { \
         union_name##_##name1 = 1, \
         union_name##_##name2 = 2, \
@@ -1343,9 +2933,8 @@ CreateOptionPtr(size_t, size_t_ptr)
         union_name##_##name8 = 8 \
     }; \
     \
-    typedef struct { \
-        uint32_t tag; \
-        uint32_t _padding; \
+    typedef struct TAG_UNION_ATTR_##layout TAG_UNION_SLOT_##layout(slot) { \
+        TAG_UNION_HEAD_##layout \
         union { \
             type1 name1; \
             type2 name2; \
@@ -1355,43 +2944,45 @@ CreateOptionPtr(size_t, size_t_ptr)
             type6 name6; \
             type7 name7; \
             type8 name8; \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
+        TAG_UNION_TAIL_##layout(8) \
     } union_name; \
     \
     static inline union_name new_##union_name##_##name1(type1 val) { \
-        return (union_name){union_name##_##name1, 0, .name1 = val}; \
+        return (union_name){.tag = union_name##_##name1, .name1 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name2(type2 val) { \
-        return (union_name){union_name##_##name2, 0, .name2 = val}; \
+        return (union_name){.tag = union_name##_##name2, .name2 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name3(type3 val) { \
-        return (union_name){union_name##_##name3, 0, .name3 = val}; \
+        return (union_name){.tag = union_name##_##name3, .name3 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name4(type4 val) { \
-        return (union_name){union_name##_##name4, 0, .name4 = val}; \
+        return (union_name){.tag = union_name##_##name4, .name4 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name5(type5 val) { \
-        return (union_name){union_name##_##name5, 0, .name5 = val}; \
+        return (union_name){.tag = union_name##_##name5, .name5 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name6(type6 val) { \
-        return (union_name){union_name##_##name6, 0, .name6 = val}; \
+        return (union_name){.tag = union_name##_##name6, .name6 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name7(type7 val) { \
-        return (union_name){union_name##_##name7, 0, .name7 = val}; \
+        return (union_name){.tag = union_name##_##name7, .name7 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name8(type8 val) { \
-        return (union_name){union_name##_##name8, 0, .name8 = val}; \
+        return (union_name){.tag = union_name##_##name8, .name8 = val}; \
     }
 
 // Implementation for 9 variants (18 args after union_name)
-#define TAG_UNION_18(union_name, type1, name1, type2, name2, type3, name3, type4, name4, type5, name5, type6, name6, type7, name7, type8, name8, type9, name9) \
+#define TAG_UNION_18(layout, slot, union_name, type1, name1, type2, name2, type3, name3, type4, name4, type5, name5, type6, name6, type7, name7, type8, name8, type9, name9) \
     enum { \
         union_name##_##name1 = 1, \
         union_name##_##name2 = 2, \
@@ -1404,9 +2995,8 @@ CreateOptionPtr(size_t, size_t_ptr)
         union_name##_##name9 = 9 \
     }; \
     \
-    typedef struct { \
-        uint32_t tag; \
-        uint32_t _padding; \
+    typedef struct TAG_UNION_ATTR_##layout TAG_UNION_SLOT_##layout(slot) { \
+        TAG_UNION_HEAD_##layout \
         union { \
             type1 name1; \
             type2 name2; \
@@ -1417,47 +3007,49 @@ CreateOptionPtr(size_t, size_t_ptr)
             type7 name7; \
             type8 name8; \
             type9 name9; \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
+        TAG_UNION_TAIL_##layout(9) \
     } union_name; \
     \
     static inline union_name new_##union_name##_##name1(type1 val) { \
-        return (union_name){union_name##_##name1, 0, .name1 = val}; \
+        return (union_name){.tag = union_name##_##name1, .name1 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name2(type2 val) { \
-        return (union_name){union_name##_##name2, 0, .name2 = val}; \
+        return (union_name){.tag = union_name##_##name2, .name2 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name3(type3 val) { \
-        return (union_name){union_name##_##name3, 0, .name3 = val}; \
+        return (union_name){.tag = union_name##_##name3, .name3 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name4(type4 val) { \
-        return (union_name){union_name##_##name4, 0, .name4 = val}; \
+        return (union_name){.tag = union_name##_##name4, .name4 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name5(type5 val) { \
-        return (union_name){union_name##_##name5, 0, .name5 = val}; \
+        return (union_name){.tag = union_name##_##name5, .name5 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name6(type6 val) { \
-        return (union_name){union_name##_##name6, 0, .name6 = val}; \
+        return (union_name){.tag = union_name##_##name6, .name6 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name7(type7 val) { \
-        return (union_name){union_name##_##name7, 0, .name7 = val}; \
+        return (union_name){.tag = union_name##_##name7, .name7 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name8(type8 val) { \
-        return (union_name){union_name##_##name8, 0, .name8 = val}; \
+        return (union_name){.tag = union_name##_##name8, .name8 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name9(type9 val) { \
-        return (union_name){union_name##_##name9, 0, .name9 = val}; \
+        return (union_name){.tag = union_name##_##name9, .name9 = val}; \
     }
 
 // Implementation for 10 variants (20 args after union_name)
-#define TAG_UNION_20(union_name, type1, name1, type2, name2, type3, name3, type4, name4, type5, name5, type6, name6, type7, name7, type8, name8, type9, name9, type10, name10) \
+#define TAG_UNION_20(layout, slot, union_name, type1, name1, type2, name2, type3, name3, type4, name4, type5, name5, type6, name6, type7, name7, type8, name8, type9, name9, type10, name10) \
     enum { \
         union_name##_##name1 = 1, \
         union_name##_##name2 = 2, \
@@ -1471,9 +3063,8 @@ CreateOptionPtr(size_t, size_t_ptr)
         union_name##_##name10 = 10 \
     }; \
     \
-    typedef struct { \
-        uint32_t tag; \
-        uint32_t _padding; \
+    typedef struct TAG_UNION_ATTR_##layout TAG_UNION_SLOT_##layout(slot) { \
+        TAG_UNION_HEAD_##layout \
         union { \
             type1 name1; \
             type2 name2; \
@@ -1485,47 +3076,49 @@ CreateOptionPtr(size_t, size_t_ptr)
             type8 name8; \
             type9 name9; \
             type10 name10; \
+            char _payload; /* names the payload offset, see it() */ \
         }; \
+        TAG_UNION_TAIL_##layout(10) \
     } union_name; \
     \
     static inline union_name new_##union_name##_##name1(type1 val) { \
-        return (union_name){union_name##_##name1, 0, .name1 = val}; \
+        return (union_name){.tag = union_name##_##name1, .name1 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name2(type2 val) { \
-        return (union_name){union_name##_##name2, 0, .name2 = val}; \
+        return (union_name){.tag = union_name##_##name2, .name2 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name3(type3 val) { \
-        return (union_name){union_name##_##name3, 0, .name3 = val}; \
+        return (union_name){.tag = union_name##_##name3, .name3 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name4(type4 val) { \
-        return (union_name){union_name##_##name4, 0, .name4 = val}; \
+        return (union_name){.tag = union_name##_##name4, .name4 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name5(type5 val) { \
-        return (union_name){union_name##_##name5, 0, .name5 = val}; \
+        return (union_name){.tag = union_name##_##name5, .name5 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name6(type6 val) { \
-        return (union_name){union_name##_##name6, 0, .name6 = val}; \
+        return (union_name){.tag = union_name##_##name6, .name6 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name7(type7 val) { \
-        return (union_name){union_name##_##name7, 0, .name7 = val}; \
+        return (union_name){.tag = union_name##_##name7, .name7 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name8(type8 val) { \
-        return (union_name){union_name##_##name8, 0, .name8 = val}; \
+        return (union_name){.tag = union_name##_##name8, .name8 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name9(type9 val) { \
-        return (union_name){union_name##_##name9, 0, .name9 = val}; \
+        return (union_name){.tag = union_name##_##name9, .name9 = val}; \
     } \
     \
     static inline union_name new_##union_name##_##name10(type10 val) { \
-        return (union_name){union_name##_##name10, 0, .name10 = val}; \
+        return (union_name){.tag = union_name##_##name10, .name10 = val}; \
     }
 
 #endif // MATCH_H
\ No newline at end of file
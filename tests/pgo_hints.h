@@ -0,0 +1,21 @@
+// Generated by tools/match_pgo from tests/pgo_profile.tsv - do not edit
+// Branch hints for tests/test_pgo.c; include before match.h there and nowhere else.
+
+#define MATCH_HINTS
+
+// tests/test_pgo.c:16 packet_class() - entered 1000 times
+#define MATCH_HINT_L17       ~, 10    // arm 0 when: 10 of 1000
+#define MATCH_HINT_L18       ~, 91    // arm 1 when: 90 of 990
+#define MATCH_HINT_L19       ~, 1000  // arm 2 when: 900 of 900
+// Hottest first: arm 2 (line 19), arm 1 (line 18), arm 0 (line 17)
+// Reorder by hand only if those arms are disjoint.
+
+// tests/test_pgo.c:26 size_class() - entered 1000 times
+#define MATCH_HINT_L27       ~, 20    // arm 0 is: 20 of 1000
+#define MATCH_HINT_L28       ~, 184   // arm 1 is: 180 of 980
+// Hottest first: arm 1 (line 28), arm 0 (line 27)
+// Reorder by hand only if those arms are disjoint.
+
+// tests/test_pgo.c:34 one_liner() - entered 1000 times
+// line 34: arm 0 shares its line with another arm - no hint
+// line 34: arm 1 shares its line with another arm - no hint
@@ -0,0 +1,288 @@
+// Generated by tools/match_tree from tests/routing_rules.match - do not edit
+
+static int route_tree(int proto, int port, int vlan, int zone, int prio) {
+    switch (proto) {
+    case 6:
+        switch (port) {
+        case 80:
+            goto match_arm_0;
+        case 443:
+            goto match_arm_1;
+        case 22:
+            switch (vlan) {
+            case 100:
+                if (prio > (5)) {
+                    goto match_arm_5;
+                } else {
+                    goto match_arm_7;
+                }
+            default:
+                if (vlan != (0)) {
+                    goto match_arm_7;
+                } else {
+                    if (zone > (2) && zone < (6)) {
+                        goto match_arm_9;
+                    } else {
+                        goto match_otherwise;
+                    }
+                }
+            }
+        default:
+            switch (vlan) {
+            case 100:
+                if (port >= (8000)) {
+                    goto match_arm_2;
+                } else {
+                    if (prio > (5)) {
+                        goto match_arm_5;
+                    } else {
+                        switch (zone) {
+                        case 1:
+                            if (port >= (1024) && port <= (65535)) {
+                                goto match_arm_6;
+                            } else {
+                                goto match_otherwise;
+                            }
+                        default:
+                            if (zone > (2) && zone < (6)) {
+                                goto match_arm_9;
+                            } else {
+                                goto match_otherwise;
+                            }
+                        }
+                    }
+                }
+            default:
+                switch (zone) {
+                case 1:
+                    if (port >= (1024) && port <= (65535)) {
+                        goto match_arm_6;
+                    } else {
+                        goto match_otherwise;
+                    }
+                default:
+                    if (zone > (2) && zone < (6)) {
+                        goto match_arm_9;
+                    } else {
+                        goto match_otherwise;
+                    }
+                }
+            }
+        }
+    case 17:
+        switch (port) {
+        case 53:
+            switch (zone) {
+            case 0:
+                goto match_arm_3;
+            default:
+                if (prio > (5)) {
+                    goto match_arm_4;
+                } else {
+                    if (zone > (2) && zone < (6)) {
+                        goto match_arm_9;
+                    } else {
+                        goto match_otherwise;
+                    }
+                }
+            }
+        case 22:
+            switch (vlan) {
+            case 100:
+                if (prio > (5)) {
+                    goto match_arm_5;
+                } else {
+                    goto match_arm_7;
+                }
+            default:
+                if (vlan != (0)) {
+                    goto match_arm_7;
+                } else {
+                    if (zone > (2) && zone < (6)) {
+                        goto match_arm_9;
+                    } else {
+                        goto match_otherwise;
+                    }
+                }
+            }
+        default:
+            switch (vlan) {
+            case 100:
+                if (prio > (5)) {
+                    goto match_arm_5;
+                } else {
+                    if (zone > (2) && zone < (6)) {
+                        goto match_arm_9;
+                    } else {
+                        goto match_otherwise;
+                    }
+                }
+            default:
+                if (zone > (2) && zone < (6)) {
+                    goto match_arm_9;
+                } else {
+                    goto match_otherwise;
+                }
+            }
+        }
+    case 1:
+        switch (vlan) {
+        case 100:
+            if (prio > (5)) {
+                goto match_arm_5;
+            } else {
+                switch (port) {
+                case 22:
+                    goto match_arm_7;
+                default:
+                    if (prio <= (2)) {
+                        goto match_arm_8;
+                    } else {
+                        if (zone > (2) && zone < (6)) {
+                            goto match_arm_9;
+                        } else {
+                            goto match_otherwise;
+                        }
+                    }
+                }
+            }
+        default:
+            switch (port) {
+            case 22:
+                if (vlan != (0)) {
+                    goto match_arm_7;
+                } else {
+                    if (prio <= (2)) {
+                        goto match_arm_8;
+                    } else {
+                        if (zone > (2) && zone < (6)) {
+                            goto match_arm_9;
+                        } else {
+                            goto match_otherwise;
+                        }
+                    }
+                }
+            default:
+                if (prio <= (2)) {
+                    goto match_arm_8;
+                } else {
+                    if (zone > (2) && zone < (6)) {
+                        goto match_arm_9;
+                    } else {
+                        goto match_otherwise;
+                    }
+                }
+            }
+        }
+    default:
+        switch (vlan) {
+        case 100:
+            if (prio > (5)) {
+                goto match_arm_5;
+            } else {
+                switch (port) {
+                case 22:
+                    goto match_arm_7;
+                default:
+                    if (zone > (2) && zone < (6)) {
+                        goto match_arm_9;
+                    } else {
+                        goto match_otherwise;
+                    }
+                }
+            }
+        default:
+            switch (port) {
+            case 22:
+                if (vlan != (0)) {
+                    goto match_arm_7;
+                } else {
+                    if (zone > (2) && zone < (6)) {
+                        goto match_arm_9;
+                    } else {
+                        goto match_otherwise;
+                    }
+                }
+            default:
+                if (zone > (2) && zone < (6)) {
+                    goto match_arm_9;
+                } else {
+                    goto match_otherwise;
+                }
+            }
+        }
+    }
+match_arm_0:
+    { return 1; }
+    goto match_done;
+match_arm_1:
+    { return 2; }
+    goto match_done;
+match_arm_2:
+    { return 10; }
+    goto match_done;
+match_arm_3:
+    { return 3; }
+    goto match_done;
+match_arm_4:
+    { return 4; }
+    goto match_done;
+match_arm_5:
+    { return 5; }
+    goto match_done;
+match_arm_6:
+    { return 6; }
+    goto match_done;
+match_arm_7:
+    { return 7; }
+    goto match_done;
+match_arm_8:
+    { return 8; }
+    goto match_done;
+match_arm_9:
+    { return 9; }
+    goto match_done;
+match_otherwise:
+    { return 0; }
+    goto match_done;
+match_done:
+    ;
+}
+
+static void count_tree(char kind, int size, int *counts) {
+    switch (kind) {
+    case 'a':
+        if (size < (10)) {
+            goto match_arm_0;
+        } else {
+            goto match_arm_1;
+        }
+    case '\n':
+        if (size >= (1000)) {
+            goto match_arm_2;
+        } else {
+            goto match_arm_3;
+        }
+    default:
+        if (size >= (1000)) {
+            goto match_arm_2;
+        } else {
+            goto match_done;
+        }
+    }
+match_arm_0:
+    { counts[0]++; }
+    goto match_done;
+match_arm_1:
+    { counts[1]++; }
+    goto match_done;
+match_arm_2:
+    { counts[2]++; }
+    goto match_done;
+match_arm_3:
+    { counts[3]++; }
+    goto match_done;
+match_done:
+    ;
+}
+
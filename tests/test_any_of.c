@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <assert.h>
+#include <math.h>
+#include "../match.h"
+
+typedef enum { TOK_PLUS, TOK_MINUS, TOK_STAR, TOK_SLASH, TOK_NUM, TOK_IDENT, TOK_EOF } Token;
+
+static int is_operator(Token t) {
+    return let(t) in(is(any_of(TOK_PLUS, TOK_MINUS, TOK_STAR, TOK_SLASH)) ? 1 : 0);
+}
+
+void test_small_sets() {
+    printf("Testing any_of() with values in 0..63...\n");
+
+    assert(is_operator(TOK_PLUS) && is_operator(TOK_SLASH));
+    assert(!is_operator(TOK_NUM) && !is_operator(TOK_EOF));
+
+    // Out-of-range subjects never hit the mask, even ones congruent mod 64
+    for (int x = -200; x <= 200; x++) {
+        int expected = x == 0 || x == 7 || x == 63;
+        assert(let_strict(x) in(is(any_of(0, 7, 63)) ? 1 : 0) == expected);
+    }
+
+    int vowel = 0;
+    match('e' - 'a') {
+        when(any_of('a' - 'a', 'e' - 'a', 'i' - 'a', 'o' - 'a', 'u' - 'a')) { vowel = 1; }
+        otherwise { vowel = 2; }
+    }
+    assert(vowel == 1);
+
+    printf("✓ Mask sets match exactly their members\n");
+}
+
+void test_large_sets() {
+    printf("Testing any_of() with wide values...\n");
+
+    // HTTP status codes that should be retried
+    for (int status = 100; status < 600; status++) {
+        int expected = status == 408 || status == 429 || status == 500 || status == 502 ||
+                       status == 503 || status == 504;
+        int retry = let_strict(status) in(is(any_of(408, 429, 500, 502, 503, 504)) ? 1 : 0);
+        assert(retry == expected);
+    }
+
+    // Negative and 64-bit members, and every set size up to the limit
+    int64_t big = INT64_C(1) << 40;
+    assert(let_strict(big) in(is(any_of(-1, INT64_C(1) << 40)) ? 1 : 0) == 1);
+    assert(let_strict(big + 1) in(is(any_of(-1, INT64_C(1) << 40)) ? 1 : 0) == 0);
+    assert(let_strict(-1) in(is(any_of(-1, INT64_C(1) << 40)) ? 1 : 0) == 1);
+    assert(let_strict(100) in(is(any_of(100)) ? 1 : 0) == 1);
+    assert(let_strict(116) in(is(any_of(100, 101, 102, 103, 104, 105, 106, 107,
+                                        108, 109, 110, 111, 112, 113, 114, 116)) ? 1 : 0) == 1);
+    assert(let_strict(115) in(is(any_of(100, 101, 102, 103, 104, 105, 106, 107,
+                                        108, 109, 110, 111, 112, 113, 114, 116)) ? 1 : 0) == 0);
+
+    printf("✓ SIMD sets match exactly their members\n");
+}
+
+void test_sets_in_columns() {
+    printf("Testing any_of() alongside other patterns...\n");
+
+    int method = 2, status = 503;
+    int action = let_strict(method, status) in(
+        is(any_of(1, 2), any_of(500, 502, 503)) ? 1
+        : is(__, any_of(200, 204)) ? 2
+        : 0
+    );
+    assert(action == 1);
+
+    // Double subjects compare by value
+    assert(let(3.0) in(is(any_of(1, 3, 5)) ? 1 : 0) == 1);
+    assert(let(3.5) in(is(any_of(1, 3, 5)) ? 1 : 0) == 0);
+    assert(let(NAN) in(is(any_of(1, 3, 5)) ? 1 : 0) == 0);
+    assert(let(500.0) in(is(any_of(500, 502)) ? 1 : 0) == 1);
+
+    // Batch form falls back to the scalar loop for set arms
+    int32_t codes[] = { 200, 404, 503, 7, 204 };
+    uint8_t arms[5];
+    match_batch(codes, 5, arms, any_of(200, 204), any_of(500, 502, 503), __);
+    assert(arms[0] == 0 && arms[1] == 2 && arms[2] == 1 && arms[3] == 2 && arms[4] == 0);
+
+    printf("✓ Sets combine with multi-column, float and batch matching\n");
+}
+
+int main() {
+    printf("Running any_of tests...\n\n");
+
+    test_small_sets();
+    test_large_sets();
+    test_sets_in_columns();
+
+    printf("\n✅ All any_of tests passed!\n");
+    return 0;
+}
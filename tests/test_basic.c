@@ -92,6 +92,72 @@ void test_range_patterns() {
     printf("✓ Range pattern tests passed\n");
 }
 
+// Test patterns built from runtime values
+void test_runtime_patterns() {
+    printf("Testing runtime pattern values...\n");
+    
+    // Thresholds that are not compile-time constants (e.g. loaded from config)
+    volatile int threshold = 75;
+    volatile int low = -20, high = 40000;
+    
+    assert((match_expr(80) in(is(gt(threshold)) ? 1 : 0)) == 1);
+    assert((match_expr(75) in(is(gt(threshold)) ? 1 : 0)) == 0);
+    assert((match_expr(75) in(is(ge(threshold)) ? 1 : 0)) == 1);
+    assert((match_expr(-5) in(is(between(low, high)) ? 1 : 0)) == 1);
+    assert((match_expr(39999) in(is(range(low, high)) ? 1 : 0)) == 1);
+    
+    int result = 0;
+    match(threshold) {
+        when(lt(low)) { result = 1; }
+        when(le(high)) { result = 2; }
+        otherwise { result = 3; }
+    }
+    assert(result == 2);
+    
+    // Negative values keep their sign
+    assert((match_expr(-10) in(is(gt(-11)) ? 1 : 0)) == 1);
+    assert((match_expr(-10) in(is(lt(-9)) ? 1 : 0)) == 1);
+    assert((match_expr(-10) in(is(ne(-10)) ? 1 : 0)) == 0);
+    
+    printf("✓ Runtime pattern tests passed\n");
+}
+
+// Test that range bounds keep their full 64-bit width
+void test_wide_range_patterns() {
+    printf("Testing 64-bit range bounds...\n");
+    
+    // Latency buckets in microseconds, well past the old 16-bit limit
+    int64_t latency_us = 2500000;
+    assert((let(latency_us) in(is(between(1000000, 5000000)) ? 1 : 0)) == 1);
+    assert((let(latency_us) in(is(range(2500000, 5000000)) ? 1 : 0)) == 0);
+    assert((let(latency_us) in(is(range(2499999, 2500001)) ? 1 : 0)) == 1);
+    assert((let(latency_us) in(is(between(32768, 65535)) ? 1 : 0)) == 0);
+    
+    // Bounds that only fit in 64 bits
+    int64_t big = INT64_C(5000000000);
+    assert((let(big) in(is(between(INT64_C(4294967296), INT64_C(8589934592))) ? 1 : 0)) == 1);
+    assert((let(big) in(is(range(INT64_MIN, INT64_C(5000000000))) ? 1 : 0)) == 0);
+    assert((let(-big) in(is(between(INT64_MIN, -INT64_C(4294967296))) ? 1 : 0)) == 1);
+    
+    // Unsigned bounds compare unsigned, including values above INT64_MAX
+    uint64_t bytes = UINT64_C(1) << 63;
+    assert((let(bytes) in(is(between(UINT64_C(1) << 62, UINT64_MAX)) ? 1 : 0)) == 1);
+    assert((let(bytes) in(is(range(0ULL, UINT64_C(1) << 63)) ? 1 : 0)) == 0);
+    assert((let(UINT64_MAX) in(is(ubetween(1, -1)) ? 1 : 0)) == 1);
+    assert((let(UINT64_MAX) in(is(between(1, 100)) ? 1 : 0)) == 0);
+    
+    int result = 0;
+    match(bytes) {
+        when(range(0ULL, 4096ULL)) { result = 1; }
+        when(between(4096ULL, UINT64_C(1) << 40)) { result = 2; }
+        when(ubetween(UINT64_C(1) << 40, UINT64_MAX)) { result = 3; }
+        otherwise { result = 4; }
+    }
+    assert(result == 3);
+    
+    printf("✓ 64-bit range tests passed\n");
+}
+
 // Test multi-argument matching
 void test_multi_argument_matching() {
     printf("Testing multi-argument matching...\n");
@@ -406,6 +472,8 @@ int main() {
     test_wildcard_matching();
     test_inequality_patterns();
     test_range_patterns();
+    test_runtime_patterns();
+    test_wide_range_patterns();
     test_multi_argument_matching();
     test_expression_form();
     test_do_blocks();
@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "../match.h"
+
+#define COUNT 1003  // not a multiple of any vector width
+
+static int32_t subjects[COUNT];
+static uint8_t arms_out[COUNT];
+
+static uint8_t grade_arm(int32_t score) {
+    return let_strict(score) in(
+        is(ge(90)) ? 0
+        : is(ge(80)) ? 1
+        : is(ge(70)) ? 2
+        : is(ge(60)) ? 3
+        : 4
+    );
+}
+
+static uint8_t mixed_arm(int32_t value) {
+    return let_strict(value) in(
+        is(gt(50)) ? 0
+        : is(between(20, 30)) ? 1
+        : is(0) ? 2
+        : is(ne(-5)) ? 3
+        : 4
+    );
+}
+
+static void fill(unsigned seed, int32_t lo, int32_t span) {
+    srand(seed);
+    for (int i = 0; i < COUNT; i++) subjects[i] = lo + (int32_t)(rand() % span);
+}
+
+void test_batch_matches_let() {
+    printf("Testing match_batch against let...\n");
+    
+    fill(1, -10, 120);
+    match_batch(subjects, COUNT, arms_out, ge(90), ge(80), ge(70), ge(60), __);
+    for (int i = 0; i < COUNT; i++) assert(arms_out[i] == grade_arm(subjects[i]));
+    
+    fill(2, -10, 80);
+    match_batch(subjects, COUNT, arms_out, gt(50), between(20, 30), 0, ne(-5), __);
+    for (int i = 0; i < COUNT; i++) assert(arms_out[i] == mixed_arm(subjects[i]));
+    
+    printf("✓ Batch results agree with per-element let\n");
+}
+
+void test_batch_no_match_and_edges() {
+    printf("Testing unmatched elements and int32 edges...\n");
+    
+    int32_t edge[] = { INT32_MIN, -1, 0, 1, 32767, 32768, 1 << 20, INT32_MAX, 7 };
+    uint8_t out[9];
+    
+    // Without a wildcard, unmatched elements get the arm count
+    match_batch(edge, 9, out, 0, between(1, 32767));
+    uint8_t expected[] = { 2, 2, 0, 1, 1, 2, 2, 2, 1 };
+    for (int i = 0; i < 9; i++) assert(out[i] == expected[i]);
+    
+    // Bounds past int32 clamp instead of wrapping
+    match_batch(edge, 9, out, lt(INT64_C(-5000000000)), ge(INT64_C(5000000000)), gt(INT32_MAX), le(INT32_MIN));
+    uint8_t edge_expected[] = { 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+    for (int i = 0; i < 9; i++) assert(out[i] == edge_expected[i]);
+    
+    // Empty ranges never match
+    match_batch(edge, 9, out, range(5, 6), __);
+    for (int i = 0; i < 9; i++) assert(out[i] == 1);
+    
+    printf("✓ Unmatched and edge values are classified correctly\n");
+}
+
+void test_batch_backends() {
+    printf("Testing every batch kernel...\n");
+    
+    fill(3, -200, 400);
+    MatchPattern patterns[] = { lt(-100), range(-50, 50), ne(150), __ };
+    MatchBatchArm arms[4];
+    for (int k = 0; k < 4; k++) assert(match_batch_arm(patterns[k], &arms[k]));
+    
+    uint8_t reference[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+        int k = 0;
+        while (!evaluate_pattern(subjects[i], patterns[k])) k++;
+        reference[i] = (uint8_t)k;
+    }
+    
+    match_batch_scalar(subjects, COUNT, arms_out, arms, 4);
+    for (int i = 0; i < COUNT; i++) assert(arms_out[i] == reference[i]);
+#if MATCH_BATCH_X86
+    if (__builtin_cpu_supports("sse4.2")) {
+        match_batch_sse42(subjects, COUNT, arms_out, arms, 4);
+        for (int i = 0; i < COUNT; i++) assert(arms_out[i] == reference[i]);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        match_batch_avx2(subjects, COUNT, arms_out, arms, 4);
+        for (int i = 0; i < COUNT; i++) assert(arms_out[i] == reference[i]);
+    }
+#endif
+    
+    printf("✓ Scalar and SIMD kernels agree\n");
+}
+
+void test_batch_scalar_fallback() {
+    printf("Testing patterns without an interval form...\n");
+    
+    int32_t values[] = { -1, 0, 5, 100 };
+    uint8_t out[4];
+    
+    // A negative int32 is a huge unsigned value, so this falls back to scalar
+    MatchBatchArm arm;
+    assert(!match_batch_arm(ubetween(-10, -1), &arm));
+    match_batch(values, 4, out, ubetween(-10, -1), ubetween(0, 10), __);
+    assert(out[0] == 0 && out[1] == 1 && out[2] == 1 && out[3] == 2);
+    
+    printf("✓ Scalar fallback handles unsigned ranges\n");
+}
+
+int main() {
+    printf("Running match_batch tests...\n\n");
+    
+    test_batch_matches_let();
+    test_batch_no_match_and_edges();
+    test_batch_backends();
+    test_batch_scalar_fallback();
+    
+    printf("\n✅ All match_batch tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include "../match.h"
+
+static int errors_logged;
+
+static int consume(Result_int *r) {
+    int value = 0;
+    match(r) {
+        when_likely(Result_Ok) { value = r->Ok; }
+        when_unlikely(Result_Err) {
+            errors_logged++;
+            value = -(int)strlen(r->Err);
+        }
+    }
+    return value;
+}
+
+static int route(int proto, int port) {
+    int arm = -1;
+    match_strict(proto, port) {
+        when_likely(6, 443) { arm = 0; }
+        when(6, __) { arm = 1; }
+        when_unlikely(__, gt(65535)) { arm = 2; }
+        otherwise { arm = 3; }
+    }
+    return arm;
+}
+
+static const char *grade(int score) {
+    return let(score) in(
+        is_cold(lt(0)) ? "invalid"
+        : is(ge(90)) ? "A"
+        : is_cold(gt(100)) ? "invalid"
+        : "B"
+    );
+}
+
+void test_annotated_when() {
+    printf("Testing when_likely() and when_unlikely()...\n");
+
+    Result_int ok = ok_int(7), err = err_int("boom");
+    assert(consume(&ok) == 7);
+    assert(consume(&err) == -4 && errors_logged == 1);
+
+    assert(route(6, 443) == 0);
+    assert(route(6, 80) == 1);
+    assert(route(17, 70000) == 2);
+    assert(route(6, 70000) == 1);   // first match still wins
+    assert(route(17, 53) == 3);
+
+    printf("✓ Annotated arms keep first-match order and otherwise\n");
+}
+
+void test_cold_is() {
+    printf("Testing is_cold() in let() ladders...\n");
+
+    assert(strcmp(grade(-3), "invalid") == 0);
+    assert(strcmp(grade(95), "A") == 0);
+    assert(strcmp(grade(120), "A") == 0);   // ge(90) comes first
+    assert(strcmp(grade(50), "B") == 0);
+
+    int code = 404, retries = 3;
+    int verdict = let(code, retries) in(
+        is_cold(500, gt(2)) ? 2
+        : is_cold(404, __) ? 1
+        : 0
+    );
+    assert(verdict == 1);
+
+    printf("✓ is_cold() only changes layout\n");
+}
+
+int main() {
+    printf("Running branch annotation tests...\n\n");
+
+    test_annotated_when();
+    test_cold_is();
+
+    printf("\n✅ All branch annotation tests passed!\n");
+    return 0;
+}
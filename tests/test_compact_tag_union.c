@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <assert.h>
+#include "../match.h"
+
+tag_union(Sample,
+    int, Count,
+    float, Ratio
+)
+
+tag_union_compact(Event,
+    int, Count,
+    float, Ratio
+)
+
+tag_union_packed(Reading,
+    double, Celsius,
+    int, Fault,
+    char, Unit
+)
+
+tag_union_compact(Token,
+    int, Number,
+    char*, Word,
+    double, Real,
+    char, Punct
+)
+
+void test_compact_sizes() {
+    printf("Testing compact layout sizes...\n");
+
+    _Static_assert(sizeof(Sample) == 12, "classic layout keeps its padding word");
+    _Static_assert(sizeof(Event) == 8, "int/float payload plus a byte tag");
+    _Static_assert(sizeof(Reading) == 9, "packed double payload plus a byte tag");
+
+    _Static_assert(match_tag_width(Event) == 1, "two variants fit in uint8_t");
+    _Static_assert(match_tag_offset(Event) == 4, "tag after the payload");
+    _Static_assert(match_payload_offset(Event) == 0, "payload first");
+    _Static_assert(match_tag_offset(Reading) == 8, "packed tag right after a double");
+    _Static_assert(match_tag_offset(Token) == 8, "tag after the widest payload");
+
+    printf("✓ Event is %zu bytes, Reading %zu, Token %zu (Sample %zu)\n",
+           sizeof(Event), sizeof(Reading), sizeof(Token), sizeof(Sample));
+}
+
+void test_compact_matching() {
+    printf("Testing match/when/let on compact unions...\n");
+
+    Event events[] = { new_Event_Count(3), new_Event_Ratio(0.5f), new_Event_Count(4) };
+    int counts = 0;
+    float ratios = 0;
+    for (int i = 0; i < 3; i++) {
+        match(&events[i]) {
+            when(variant(Event_Count)) { counts += events[i].Count; }
+            when(variant(Event_Ratio)) { ratios += events[i].Ratio; }
+        }
+    }
+    assert(counts == 7 && ratios == 0.5f);
+
+    // The int payload shares its bytes with nothing else: a Count of 1 must
+    // not be mistaken for the Event_Count tag
+    Event one = new_Event_Ratio(1.0f);
+    assert(let(&one) in(is(variant(Event_Count)) ? 1 : is(variant(Event_Ratio)) ? 2 : 0) == 2);
+
+    Token tokens[] = { new_Token_Number(42), new_Token_Word("let"), new_Token_Real(2.5), new_Token_Punct(';') };
+    const char *kinds = "";
+    for (int i = 0; i < 4; i++) {
+        kinds = let_strict(&tokens[i]) in(
+            is(variant(Token_Number)) ? "number"
+            : is(variant(Token_Word)) ? "word"
+            : is(variant(Token_Real)) ? "real"
+            : "punct"
+        );
+    }
+    assert(kinds[0] == 'p');
+
+    double total = 0;
+    for (int i = 0; i < 4; i++) {
+        match(&tokens[i]) {
+            when_bind(variant(Token_Number), int, n) { total += n; }
+            when_bind(variant(Token_Real), double, r) { total += r; }
+        }
+    }
+    assert(total == 44.5);
+
+    // variant_value() reads at the compact payload offset, inside the 8 bytes
+    Event count = new_Event_Count(9);
+    int value = 0;
+    match_strict(&count) {
+        when(variant(Event_Count)) { value = variant_value(int); }
+    }
+    assert(value == 9);
+
+    printf("✓ variant() reads the byte tag after the payload\n");
+}
+
+void test_packed_matching() {
+    printf("Testing packed unions...\n");
+
+    Reading readings[] = { new_Reading_Celsius(21.5), new_Reading_Fault(7), new_Reading_Unit('F') };
+    double sum = 0;
+    int fault = 0;
+    char unit = 0;
+    for (int i = 0; i < 3; i++) {
+        match(&readings[i]) {
+            when(variant(Reading_Celsius)) { sum += readings[i].Celsius; }
+            when(variant(Reading_Fault)) { fault = readings[i].Fault; }
+            otherwise { unit = readings[i].Unit; }
+        }
+    }
+    assert(sum == 21.5 && fault == 7 && unit == 'F');
+
+    // Past the first element the double payloads are misaligned; binding them
+    // must still be a plain (memcpy) read
+    Reading series[] = { new_Reading_Celsius(1.5), new_Reading_Celsius(2.0),
+                         new_Reading_Fault(4), new_Reading_Celsius(-0.5) };
+    double bound = 0;
+    int faults = 0;
+    for (int i = 0; i < 4; i++) {
+        match(&series[i]) {
+            when_bind(variant(Reading_Celsius), double, d) { bound += d; }
+            when_bind(variant(Reading_Fault), int, f) { faults += f; }
+        }
+    }
+    assert(bound == 3.0 && faults == 4);
+    assert(let(&series[1]) in(is(variant(Reading_Celsius)) ? it(double) : 0.0) == 2.0);
+
+    printf("✓ Packed unions match without padding\n");
+}
+
+void test_literal_tags() {
+    printf("Testing plain when(Tag) on compact and packed unions...\n");
+
+    // Payloads equal to another variant's tag must not be read as the tag
+    Event events[] = { new_Event_Count(2), new_Event_Count(1), new_Event_Ratio(2.0f), new_Event_Count(0) };
+    int counts = 0, ratios = 0;
+    for (int i = 0; i < 4; i++) {
+        match(&events[i]) {
+            when(Event_Count) { counts++; }
+            when(Event_Ratio) { ratios++; }
+        }
+    }
+    assert(counts == 3 && ratios == 1);
+
+    Reading faulty = new_Reading_Fault(1), unit = new_Reading_Unit(3);
+    assert(let(&faulty) in(is(Reading_Celsius) ? 1 : is(Reading_Fault) ? 2 : 3) == 2);
+    assert(let(&unit) in(is(Reading_Celsius) ? 1 : is(Reading_Fault) ? 2 : 3) == 3);
+
+    Token tokens[] = { new_Token_Number(4), new_Token_Punct(3), new_Token_Real(1.0) };
+    int kinds = 0;
+    for (int i = 0; i < 3; i++) {
+        match(&tokens[i]) {
+            when(Token_Number) { kinds += 1; }
+            when(Token_Word) { kinds += 10; }
+            when(Token_Real) { kinds += 100; }
+            when(Token_Punct) { kinds += 1000; }
+        }
+    }
+    assert(kinds == 1101);
+
+    printf("✓ Literal tags read the real tag in auto mode\n");
+}
+
+int main() {
+    printf("Running compact tag_union tests...\n\n");
+
+    test_compact_sizes();
+    test_compact_matching();
+    test_packed_matching();
+    test_literal_tags();
+
+    printf("\n✅ All compact tag_union tests passed!\n");
+    return 0;
+}
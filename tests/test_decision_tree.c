@@ -0,0 +1,93 @@
+/*
+ * Test file for decision-tree compiled arm tables
+ *
+ * routing_rules.h is generated by tools/match_tree from routing_rules.match.
+ * Every generated function must pick the same arm as the equivalent
+ * match() statement for every input.
+ */
+
+#include "../match.h"
+#include <stdio.h>
+#include <assert.h>
+#include "routing_rules.h"
+
+static int route_match(int proto, int port, int vlan, int zone, int prio) {
+    match_strict(proto, port, vlan, zone, prio) {
+        when(6, 80, __, __, __) { return 1; }
+        when(6, 443, __, __, __) { return 2; }
+        when(6, ge(8000), 100, __, __) { return 10; }
+        when(17, 53, __, 0, __) { return 3; }
+        when(17, 53, __, __, gt(5)) { return 4; }
+        when(__, __, 100, __, gt(5)) { return 5; }
+        when(6, between(1024, 65535), __, 1, __) { return 6; }
+        when(__, 22, ne(0), __, __) { return 7; }
+        when(1, __, __, __, le(2)) { return 8; }
+        when(__, __, __, range(2, 6), __) { return 9; }
+        otherwise { return 0; }
+    }
+    return -1;
+}
+
+static void count_match(char kind, int size, int *counts) {
+    match_strict(kind, size) {
+        when('a', lt(10)) { counts[0]++; }
+        when('a', __) { counts[1]++; }
+        when(__, ge(1000)) { counts[2]++; }
+        when('\n', __) { counts[3]++; }
+    }
+}
+
+void test_routing_table() {
+    printf("Testing generated routing tree...\n");
+    
+    static const int protos[] = { 0, 1, 6, 17, 255 };
+    static const int ports[] = { 0, 22, 53, 80, 443, 1023, 1024, 8000, 65535, 65536 };
+    static const int vlans[] = { 0, 1, 100, 4095 };
+    static const int zones[] = { -1, 0, 1, 2, 3, 5, 6 };
+    static const int prios[] = { 0, 2, 3, 5, 6, 7 };
+    
+    int checked = 0;
+    for (size_t a = 0; a < sizeof(protos) / sizeof(protos[0]); a++)
+    for (size_t b = 0; b < sizeof(ports) / sizeof(ports[0]); b++)
+    for (size_t c = 0; c < sizeof(vlans) / sizeof(vlans[0]); c++)
+    for (size_t d = 0; d < sizeof(zones) / sizeof(zones[0]); d++)
+    for (size_t e = 0; e < sizeof(prios) / sizeof(prios[0]); e++) {
+        int expected = route_match(protos[a], ports[b], vlans[c], zones[d], prios[e]);
+        assert(route_tree(protos[a], ports[b], vlans[c], zones[d], prios[e]) == expected);
+        checked++;
+    }
+    
+    assert(route_tree(6, 80, 0, 0, 0) == 1);
+    assert(route_tree(6, 9000, 100, 0, 0) == 10);
+    assert(route_tree(17, 53, 7, 4, 1) == 9);
+    assert(route_tree(1, 5, 5, 0, 2) == 8);
+    
+    printf("✓ Tree agrees with match() on %d inputs\n", checked);
+}
+
+void test_void_table() {
+    printf("Testing generated statement bodies...\n");
+    
+    static const char kinds[] = { 'a', 'b', '\n', 0 };
+    static const int sizes[] = { 0, 9, 10, 999, 1000, 5000 };
+    
+    for (size_t a = 0; a < sizeof(kinds) / sizeof(kinds[0]); a++)
+    for (size_t b = 0; b < sizeof(sizes) / sizeof(sizes[0]); b++) {
+        int tree_counts[4] = { 0 }, match_counts[4] = { 0 };
+        count_tree(kinds[a], sizes[b], tree_counts);
+        count_match(kinds[a], sizes[b], match_counts);
+        for (int i = 0; i < 4; i++) assert(tree_counts[i] == match_counts[i]);
+    }
+    
+    printf("✓ Arms without otherwise fall through like match()\n");
+}
+
+int main() {
+    printf("Running decision tree tests...\n\n");
+    
+    test_routing_table();
+    test_void_table();
+    
+    printf("\n✅ All decision tree tests passed!\n");
+    return 0;
+}
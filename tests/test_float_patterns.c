@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <assert.h>
+#include <math.h>
+#include "../match.h"
+
+static int classify_temp(double t) {
+    return let(t) in(
+        is(fnan) ? -1
+        : is(flt(0.0)) ? 0
+        : is(frange(0.0, 25.5)) ? 1
+        : is(fbetween(25.5, 40.0)) ? 2
+        : 3
+    );
+}
+
+void test_float_statement_form() {
+    printf("Testing float patterns in match()...\n");
+
+    double readings[] = { -12.5, 0.0, 25.5, 39.99, 40.0, 40.01 };
+    // 0.0 is on the open bound of frange() and below fgt(40.0)
+    int expected[] = { 0, 4, 2, 2, 2, 3 };
+    for (int i = 0; i < 6; i++) {
+        int result = -1;
+        match(readings[i]) {
+            when(flt(0.0)) { result = 0; }
+            when(frange(0.0, 25.5)) { result = 1; }
+            when(fbetween(25.5, 40.0)) { result = 2; }
+            when(fgt(40.0)) { result = 3; }
+            otherwise { result = 4; }
+        }
+        assert(result == expected[i]);
+    }
+
+    // Literals and fractional values are not truncated
+    int hit = 0;
+    match(0.5) {
+        when(0) { hit = 1; }
+        when(0.5) { hit = 2; }
+        otherwise { hit = 3; }
+    }
+    assert(hit == 2);
+
+    float f = -1.25f;
+    match(f) {
+        when(fle(-1.25)) { hit = 10; }
+        otherwise { hit = 11; }
+    }
+    assert(hit == 10);
+
+    printf("✓ Statement form compares doubles by value\n");
+}
+
+void test_float_expression_form() {
+    printf("Testing float patterns in let()...\n");
+
+    assert(classify_temp(-0.5) == 0);
+    assert(classify_temp(10.0) == 1);
+    assert(classify_temp(25.5) == 2);
+    assert(classify_temp(100.0) == 3);
+    assert(classify_temp(-INFINITY) == 0);
+    assert(classify_temp(INFINITY) == 3);
+
+    // Integer patterns on a double subject compare against the widened bound
+    double x = 10.5;
+    assert(let(x) in(is(gt(10)) ? 1 : 0) == 1);
+    assert(let(x) in(is(between(10, 11)) ? 1 : 0) == 1);
+    assert(let(x) in(is(10) ? 1 : 0) == 0);
+
+    // Float patterns on an integer subject
+    int n = 3;
+    assert(let_strict(n) in(is(fgt(2.5)) ? 1 : 0) == 1);
+    assert(let_strict(n) in(is(flt(2.5)) ? 1 : 0) == 0);
+
+    // Two columns, mixing float and integer subjects
+    int code = 200;
+    double latency = 0.25;
+    int verdict = let_strict(code, latency) in(
+        is(200, flt(0.1)) ? 0
+        : is(200, flt(1.0)) ? 1
+        : 2
+    );
+    assert(verdict == 1);
+
+    printf("✓ Expression form handles float and mixed subjects\n");
+}
+
+void test_nan_handling() {
+    printf("Testing NaN handling...\n");
+
+    double nan = NAN;
+    assert(classify_temp(nan) == -1);
+
+    // NaN fails every ordered pattern, like the C operators
+    assert(let(nan) in(is(fge(-INFINITY)) ? 1 : 0) == 0);
+    assert(let(nan) in(is(fle(INFINITY)) ? 1 : 0) == 0);
+    assert(let(nan) in(is(feq(nan)) ? 1 : 0) == 0);
+    assert(let(nan) in(is(fbetween(-INFINITY, INFINITY)) ? 1 : 0) == 0);
+    assert(let(nan) in(is(fne(1.0)) ? 1 : 0) == 1);
+    assert(let(nan) in(is(__) ? 1 : 0) == 1);
+    assert(let(1.0) in(is(fnan) ? 1 : 0) == 0);
+
+    int arm = -1;
+    match(nan) {
+        when(flt(0.0)) { arm = 0; }
+        when(fge(0.0)) { arm = 1; }
+        otherwise { arm = 2; }
+    }
+    assert(arm == 2);
+
+    // NaN and doubles beyond intptr_t are never converted to an integer
+    // (undefined behavior; -fsanitize=float-cast-overflow reports it)
+    match(nan) {
+        when(fnan) { arm = 3; }
+        otherwise { arm = 4; }
+    }
+    assert(arm == 3);
+    match(1e300) {
+        when(fgt(0.0)) { arm = 5; }
+        otherwise { arm = 6; }
+    }
+    assert(arm == 5);
+    assert(let(-1e300, nan) in(is(flt(0.0), fnan) ? 1 : 0) == 1);
+    assert(match_ranges(1e300, fnan, fge(1e299), __) == 1);
+    assert(match_ranges((float)NAN, fnan, __) == 0);
+
+    printf("✓ NaN only matches __, fne() and fnan\n");
+}
+
+void test_float_ranges() {
+    printf("Testing match_ranges on doubles...\n");
+
+    assert(match_ranges(0.95, fge(0.9), fge(0.5), __) == 0);
+    assert(match_ranges(0.5, fge(0.9), fge(0.5), __) == 1);
+    assert(match_ranges(0.49, fge(0.9), fge(0.5), __) == 2);
+    assert(match_ranges(NAN, fge(0.9), fge(0.5)) == 2);
+
+    printf("✓ Double ladders count failing arms\n");
+}
+
+static int first_arm(double x, const MatchPattern *arms, int narms) {
+    int k = 0;
+    while (k < narms && !evaluate_float_pattern(x, arms[k])) k++;
+    return k;
+}
+
+void test_double_batch() {
+    printf("Testing match_batch_double...\n");
+
+    enum { N = 1003 };
+    static double values[N];
+    static uint8_t arms_out[N];
+    for (int i = 0; i < N; i++) values[i] = (i - 500) * 0.125;
+    values[7] = NAN;
+    values[8] = INFINITY;
+    values[9] = -INFINITY;
+    values[10] = -0.0;
+
+    match_batch_double(values, N, arms_out, fnan, flt(-10.0), frange(-10.0, 0.0), 0.0, gt(20), __);
+    const MatchPattern p1[] = { fnan, flt(-10.0), frange(-10.0, 0.0), feq(0.0), gt(20), __ };
+    for (int i = 0; i < N; i++) assert(arms_out[i] == first_arm(values[i], p1, 6));
+
+    // ne(), open integer bounds and no catch-all
+    match_batch_double(values, N, arms_out, fne(3.0), range(-5, 5), lt(-60));
+    const MatchPattern p2[] = { fne(3.0), range(-5, 5), lt(-60) };
+    for (int i = 0; i < N; i++) assert(arms_out[i] == first_arm(values[i], p2, 3));
+
+    // Small arrays exercise the scalar tail only
+    match_batch_double(values + 5, 3, arms_out, fle(-61.8), fnan);
+    assert(arms_out[0] == 0 && arms_out[1] == 2 && arms_out[2] == 1);
+
+    printf("✓ Batch classification agrees with evaluate_float_pattern\n");
+}
+
+int main() {
+    printf("Running float pattern tests...\n\n");
+
+    test_float_statement_form();
+    test_float_expression_form();
+    test_nan_handling();
+    test_float_ranges();
+    test_double_batch();
+
+    printf("\n✅ All float pattern tests passed!\n");
+    return 0;
+}
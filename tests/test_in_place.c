@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include "../match.h"
+
+typedef struct {
+    long id;
+    char name[240];
+    long checksum;
+} Record;
+
+CreateResult(Record)
+CreateOption(Record)
+CreateResultCode(Record, ErrorCode)
+typedef int Slot;
+CreateOptionNiche(Slot, -1)
+
+static void load_record(Result_Record* out, long id) {
+    if (id < 0) {
+        *out = err_Record(ERR_INVALID_INPUT);
+        return;
+    }
+    Record* rec = ok_Record_into(out);
+    rec->id = id;
+    snprintf(rec->name, sizeof rec->name, "record-%ld", id);
+    rec->checksum = id * 31;
+}
+
+void test_into_constructors() {
+    printf("Testing ok_TYPE_into / some_TYPE_into...\n");
+
+    Result_Record r;
+    memset(&r, 0xAB, sizeof r);
+    load_record(&r, 12);
+    assert(is_ok(&r) && r.Ok.id == 12 && r.Ok.checksum == 12 * 31);
+    assert(strcmp(r.Ok.name, "record-12") == 0);
+
+    load_record(&r, -1);
+    assert(is_err(&r) && strcmp(r.Err, ERR_INVALID_INPUT) == 0);
+
+    Option_Record o = none_Record();
+    Record* slot = some_Record_into(&o);
+    assert(slot == &o.Some && is_some(&o));
+    slot->id = 5;
+    assert(o.Some.id == 5);
+
+    Result_Record_ErrorCode c = err_Record_ErrorCode(Error_Timeout);
+    ok_Record_ErrorCode_into(&c)->id = 9;
+    assert(is_ok(&c) && c.Ok.id == 9);
+
+    printf("✓ Payload slots are written in place and the tag is set\n");
+}
+
+void test_init_macros() {
+    printf("Testing OK_INIT / SOME_INIT...\n");
+
+    Result_Record r = err_Record("stale");
+    OK_INIT(&r, .id = 3, .name = "three", .checksum = 93);
+    assert(is_ok(&r) && r.Ok.id == 3 && r.Ok.checksum == 93);
+    assert(strcmp(r.Ok.name, "three") == 0);
+
+    // Fields left out are zeroed, as in any initializer list
+    OK_INIT(&r, .id = 4);
+    assert(r.Ok.checksum == 0 && r.Ok.name[0] == '\0');
+
+    Option_Record o = none_Record();
+    SOME_INIT(&o, .id = 8);
+    assert(is_some(&o) && o.Some.id == 8);
+
+    // Scalars, and a niche option whose payload is its state
+    Option_double d = none_double();
+    SOME_INIT(&d, 2.5);
+    assert(is_some(&d) && d.Some == 2.5);
+
+    Option_Slot n = none_Slot();
+    SOME_INIT(&n, 17);
+    assert(is_some(&n) && n.Some == 17);
+
+    Option_int_ptr p = none_int_ptr();
+    int target = 1;
+    SOME_INIT(&p, &target);
+    assert(is_some(&p) && *p.Some == 1);
+
+    // The result pointer is evaluated once
+    Result_Record arr[2] = { err_Record("a"), err_Record("b") };
+    Result_Record* cursor = arr;
+    OK_INIT(cursor++, .id = 1);
+    assert(cursor == arr + 1 && is_ok(&arr[0]) && is_err(&arr[1]));
+
+    printf("✓ Initializer lists build the payload inside the Result/Option\n");
+}
+
+void test_reference_access() {
+    printf("Testing unwrap_ref / as_ref...\n");
+
+    static const Record empty = { .id = -1 };
+    Result_Record r;
+    load_record(&r, 21);
+    const Record* rec = unwrap_ref(&r, &empty);
+    assert(rec == &r.Ok && rec->id == 21);
+    assert(as_ref(&r) == &r.Ok);
+
+    // Writes through the reference land in the Result
+    as_ref(&r)->checksum = 0;
+    assert(r.Ok.checksum == 0);
+
+    load_record(&r, -5);
+    assert(unwrap_ref(&r, &empty) == &empty);
+    assert(as_ref(&r) == NULL);
+
+    const Result_Record cr = r;
+    const Record* none = as_ref(&cr);
+    assert(none == NULL);
+
+    Option_Record o = none_Record();
+    assert(option_as_ref(&o) == NULL);
+    assert(unwrap_option_ref(&o, &empty)->id == -1);
+    SOME_INIT(&o, .id = 2);
+    assert(option_as_ref(&o) == &o.Some && unwrap_option_ref(&o, &empty)->id == 2);
+
+    Option_Slot n = none_Slot();
+    assert(option_as_ref(&n) == NULL);
+    SOME_INIT(&n, -1);
+    assert(is_none(&n));
+
+    printf("✓ References point into the value, or at the fallback\n");
+}
+
+int main() {
+    printf("Running in-place construction tests...\n\n");
+
+    test_into_constructors();
+    test_init_macros();
+    test_reference_access();
+
+    printf("\n✅ All in-place construction tests passed!\n");
+    return 0;
+}
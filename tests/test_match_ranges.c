@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <assert.h>
+#include "../match.h"
+
+static char grade_let(int score) {
+    return let_strict(score) in(
+        is(ge(90)) ? 'A'
+        : is(ge(80)) ? 'B'
+        : is(ge(70)) ? 'C'
+        : is(ge(60)) ? 'D'
+        : 'F'
+    );
+}
+
+void test_descending_ladder() {
+    printf("Testing descending ge() ladder...\n");
+    
+    for (int score = -50; score <= 150; score++) {
+        char grade = "ABCDF"[match_ranges(score, ge(90), ge(80), ge(70), ge(60))];
+        assert(grade == grade_let(score));
+    }
+    
+    // gt() and a trailing wildcard are nested too
+    assert(match_ranges(11, gt(100), gt(10), __) == 1);
+    assert(match_ranges(10, gt(100), gt(10), __) == 2);
+    
+    printf("✓ match_ranges agrees with the let() ladder\n");
+}
+
+void test_ascending_ladder() {
+    printf("Testing ascending lt()/le() ladder...\n");
+    
+    assert(match_ranges(5, lt(10), le(20), lt(30)) == 0);
+    assert(match_ranges(10, lt(10), le(20), lt(30)) == 1);
+    assert(match_ranges(20, lt(10), le(20), lt(30)) == 1);
+    assert(match_ranges(21, lt(10), le(20), lt(30)) == 2);
+    assert(match_ranges(30, lt(10), le(20), lt(30)) == 3);
+    
+    // 64-bit subjects and thresholds
+    int64_t big = INT64_C(7000000000);
+    assert(match_ranges(big, lt(INT64_C(1000000000)), lt(INT64_C(8000000000)), __) == 1);
+    
+    printf("✓ Unmatched subjects return the arm count\n");
+}
+
+void test_bucket_table() {
+    printf("Testing match_bucket...\n");
+    
+    static const int64_t thresholds[] = { 100, 1000, 10000, 100000, 1000000 };
+    assert(match_bucket(-1, thresholds, 5) == 0);
+    assert(match_bucket(99, thresholds, 5) == 0);
+    assert(match_bucket(100, thresholds, 5) == 1);
+    assert(match_bucket(999999, thresholds, 5) == 4);
+    assert(match_bucket(1000000, thresholds, 5) == 5);
+    assert(match_bucket(INT64_MAX, thresholds, 5) == 5);
+    assert(match_bucket(5, thresholds, 0) == 0);
+    
+    // Every table size against a linear count
+    int64_t table[33];
+    for (int i = 0; i < 33; i++) table[i] = i * 10;
+    for (size_t n = 1; n <= 33; n++) {
+        for (int64_t x = -5; x <= 335; x++) {
+            size_t expected = 0;
+            while (expected < n && table[expected] <= x) expected++;
+            assert(match_bucket(x, table, n) == expected);
+        }
+    }
+    
+    printf("✓ Bucket search matches a linear scan\n");
+}
+
+int main() {
+    printf("Running match_ranges tests...\n\n");
+    
+    test_descending_ladder();
+    test_ascending_ladder();
+    test_bucket_table();
+    
+    printf("\n✅ All match_ranges tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <assert.h>
+#include "../match.h"
+
+typedef enum {
+    MSG_HELLO = 1,
+    MSG_DATA,
+    MSG_DATA_LAST,
+    MSG_ACK,
+    MSG_NACK,
+    MSG_PING,
+    MSG_PONG,
+    MSG_BYE
+} MessageType;
+
+static int classify(int type) {
+    int result = -1;
+    match_switch(type) {
+        when_case(MSG_HELLO) { result = 10; }
+        when_case(MSG_DATA, MSG_DATA_LAST) { result = 20; }
+        when_case(MSG_ACK) { result = 30; }
+        when_case(MSG_NACK) { result = 31; }
+        when_case(MSG_PING, MSG_PONG) { result = 40; }
+        when_case(MSG_BYE) { result = 50; }
+        otherwise { result = 0; }
+    }
+    return result;
+}
+
+void test_switch_arms() {
+    printf("Testing match_switch arms...\n");
+    
+    assert(classify(MSG_HELLO) == 10);
+    assert(classify(MSG_DATA) == 20);
+    assert(classify(MSG_DATA_LAST) == 20);
+    assert(classify(MSG_ACK) == 30);
+    assert(classify(MSG_NACK) == 31);
+    assert(classify(MSG_PING) == 40);
+    assert(classify(MSG_PONG) == 40);
+    assert(classify(MSG_BYE) == 50);
+    
+    printf("✓ Each arm runs only its own body\n");
+}
+
+void test_switch_otherwise() {
+    printf("Testing otherwise as default...\n");
+    
+    assert(classify(0) == 0);
+    assert(classify(99) == 0);
+    assert(classify(-7) == 0);
+    
+    // Without otherwise an unmatched subject runs nothing
+    int result = 5;
+    match_switch(3) {
+        when_case(1) { result = 1; }
+        when_case(2) { result = 2; }
+    }
+    assert(result == 5);
+    
+    printf("✓ otherwise runs only when no case matches\n");
+}
+
+void test_switch_break_and_nesting() {
+    printf("Testing break and nesting...\n");
+    
+    int result = 0;
+    match_switch(2) {
+        when_case(2) {
+            result = 1;
+            break;
+            result = 2;
+        }
+        otherwise { result = 3; }
+    }
+    assert(result == 1);
+    
+    // A regular match inside an arm keeps its otherwise to itself
+    result = 0;
+    match_switch(MSG_DATA) {
+        when_case(MSG_DATA) {
+            match(7) {
+                when(1) { result = 1; }
+                otherwise { result = 2; }
+            }
+        }
+        otherwise { result = 3; }
+    }
+    assert(result == 2);
+    
+    // A match inside a plain switch does not capture its default
+    result = 0;
+    switch (4) {
+        case 4:
+            match(4) {
+                when(5) { result = 1; }
+                otherwise { result = 2; }
+            }
+            break;
+        default:
+            result = 3;
+            break;
+    }
+    assert(result == 2);
+    
+    printf("✓ break and nested matches behave\n");
+}
+
+int main() {
+    printf("Running match_switch tests...\n\n");
+    
+    test_switch_arms();
+    test_switch_otherwise();
+    test_switch_break_and_nesting();
+    
+    printf("\n✅ All match_switch tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include "../match.h"
+
+typedef struct { int x, y; } Point;
+
+// A user-defined niche option over a struct pointer
+CreateOptionPtrNiche(Point, Point_ptr)
+CreateOption(Point)
+
+static Option_char_ptr lookup(const char *key) {
+    if (strcmp(key, "host") == 0) return some_char_ptr("localhost");
+    if (strcmp(key, "port") == 0) return some_char_ptr("8080");
+    return none_char_ptr();
+}
+
+static size_t length(char *s) { return strlen(s); }
+static int is_long(char *s) { return strlen(s) > 4; }
+static int off_origin(Point p) { return p.x != 0 || p.y != 0; }
+
+void test_niche_layout() {
+    printf("Testing niche option layout...\n");
+
+    _Static_assert(sizeof(Option_char_ptr) == sizeof(char*), "one machine word");
+    _Static_assert(sizeof(Option_Point_ptr) == sizeof(Point*), "one machine word");
+    _Static_assert(match_payload_offset(Option_int_ptr) == 0, "payload is the whole option");
+    _Static_assert(match_tag_width(Option_void_ptr) == sizeof(void*), "tag is the pointer");
+
+    Option_char_ptr none = none_char_ptr();
+    assert(none.Some == NULL);
+    Option_char_ptr null_some = some_char_ptr(NULL);
+    assert(is_none(&null_some));
+
+    printf("✓ Pointer options are %zu bytes\n", sizeof(Option_char_ptr));
+}
+
+void test_niche_helpers() {
+    printf("Testing Option helpers on niche options...\n");
+
+    Option_char_ptr host = lookup("host");
+    Option_char_ptr user = lookup("user");
+    assert(is_some(&host) && !is_none(&host));
+    assert(is_none(&user) && !is_some(&user));
+
+    assert(strcmp(unwrap_option_or(&host, "?"), "localhost") == 0);
+    assert(strcmp(unwrap_option_or(&user, "?"), "?") == 0);
+
+    Option_size_t len = OPTION_MAP(&host, length, size_t);
+    assert(is_some(&len) && len.Some == 9);
+    Option_size_t no_len = OPTION_MAP(&user, length, size_t);
+    assert(is_none(&no_len));
+
+    Option_char_ptr port = lookup("port");
+    Option_char_ptr kept = OPTION_FILTER(&host, is_long);
+    Option_char_ptr dropped = OPTION_FILTER(&port, is_long);
+    assert(is_some(&kept) && is_none(&dropped));
+
+    Result_char_ptr res = OPTION_TO_RESULT(&user, "missing", char_ptr);
+    assert(is_err(&res));
+
+    // Tagged options keep working through the same macros
+    Point origin = { 0, 0 };
+    Option_Point p = some_Point(origin);
+    Option_Point filtered = OPTION_FILTER(&p, off_origin);
+    assert(is_none(&filtered) && filtered.tag == Option_None);
+
+    printf("✓ is_some, unwrap_option_or, OPTION_MAP and OPTION_FILTER see NULL as None\n");
+}
+
+void test_niche_matching() {
+    printf("Testing match() on niche options...\n");
+
+    const char *keys[] = { "host", "user", "port" };
+    int found = 0, missing = 0;
+    for (int i = 0; i < 3; i++) {
+        Option_char_ptr opt = lookup(keys[i]);
+        match(&opt) {
+            when(Option_Some) { found += (int)strlen(opt.Some); }
+            when(Option_None) { missing++; }
+        }
+    }
+    assert(found == 13 && missing == 1);
+
+    Option_char_ptr host = lookup("host");
+    Option_char_ptr user = lookup("user");
+    assert(let_strict(&host) in(is(variant(Option_Some)) ? 1 : is(variant(Option_None)) ? 2 : 0) == 1);
+    assert(let_strict(&user) in(is(variant(Option_Some)) ? 1 : is(variant(Option_None)) ? 2 : 0) == 2);
+
+    Point target = { 3, 4 };
+    Option_Point_ptr hit = some_Point_ptr(&target);
+    int dist = -1;
+    match(&hit) {
+        when_bind(variant(Option_Some), Point*, pt) { dist = pt->x + pt->y; }
+        when(variant(Option_None)) { dist = 0; }
+    }
+    assert(dist == 7);
+
+    // Mixed with a tagged Result in another column
+    static double ratio = 0.5;
+    Result_double_ptr res = ok_double_ptr(&ratio);
+    Option_int_ptr missing_ptr = none_int_ptr();
+    int arm = 0;
+    match(&missing_ptr, &res) {
+        when(Option_Some, Result_Ok) { arm = 1; }
+        when(Option_None, Result_Ok) { arm = 2; }
+        otherwise { arm = 3; }
+    }
+    assert(arm == 2);
+
+    printf("✓ when(Option_Some) and variant() test the pointer against NULL\n");
+}
+
+int main() {
+    printf("Running niche option tests...\n\n");
+
+    test_niche_layout();
+    test_niche_helpers();
+    test_niche_matching();
+
+    printf("\n✅ All niche option tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <assert.h>
+#include <stdlib.h>
+#define MATCH_NICHE_OPTIONS
+#include "../match.h"
+
+typedef enum { COLOR_RED, COLOR_GREEN, COLOR_BLUE, COLOR_INVALID = 255 } Color;
+typedef int Fd;
+typedef uint8_t Level;
+
+CreateOptionNiche(Color, COLOR_INVALID)
+CreateOptionNiche(Fd, -1)
+CreateOptionNiche(Level, 0xFF)
+
+static Option_int parse_digit(char c) {
+    return (c >= '0' && c <= '9') ? some_int(c - '0') : none_int();
+}
+
+static Option_size_t find(const int *values, size_t n, int target) {
+    for (size_t i = 0; i < n; i++) {
+        if (values[i] == target) return some_size_t(i);
+    }
+    return none_size_t();
+}
+
+static int square(int x) { return x * x; }
+static int is_even(int x) { return x % 2 == 0; }
+
+void test_sentinel_layout() {
+    printf("Testing sentinel niche layout...\n");
+
+    _Static_assert(sizeof(Option_int) == sizeof(int), "no tag");
+    _Static_assert(sizeof(Option_size_t) == sizeof(size_t), "no tag");
+    _Static_assert(sizeof(Option_short) == sizeof(short), "no tag");
+    _Static_assert(sizeof(Option_Color) == sizeof(Color), "no tag");
+    _Static_assert(sizeof(Option_Level) == 1, "no tag");
+    _Static_assert(sizeof(Option_double) == 16, "floating-point options stay tagged");
+
+    Option_int none = none_int();
+    assert(none.Some == INT_MIN);
+    Option_size_t missing = none_size_t();
+    assert(missing.Some == SIZE_MAX);
+
+    // The sentinel itself is None
+    Option_int min = some_int(INT_MIN);
+    assert(is_none(&min));
+
+    printf("✓ Option_int is %zu bytes, Option_Level %zu\n", sizeof(Option_int), sizeof(Option_Level));
+}
+
+void test_sentinel_helpers() {
+    printf("Testing helpers on sentinel niches...\n");
+
+    Option_int seven = parse_digit('7');
+    Option_int bad = parse_digit('x');
+    assert(is_some(&seven) && is_none(&bad));
+    assert(unwrap_option_or(&seven, -1) == 7);
+    assert(unwrap_option_or(&bad, -1) == -1);
+
+    Option_int sq = OPTION_MAP(&seven, square, int);
+    assert(is_some(&sq) && sq.Some == 49);
+    Option_int odd = OPTION_FILTER(&seven, is_even);
+    assert(is_none(&odd) && odd.Some == INT_MIN);
+
+    // Zero is an ordinary value, not None
+    Option_int zero = parse_digit('0');
+    assert(is_some(&zero) && zero.Some == 0);
+
+    const int values[] = { 4, 8, 15, 16, 23, 42 };
+    Option_size_t at = find(values, 6, 23);
+    Option_size_t nowhere = find(values, 6, 99);
+    assert(is_some(&at) && at.Some == 4);
+    assert(is_none(&nowhere));
+
+    Option_Fd fd = some_Fd(3);
+    Option_Fd closed = none_Fd();
+    assert(is_some(&fd) && is_none(&closed) && closed.Some == -1);
+
+    Level raw = 0xFF;
+    Option_Level level = some_Level(raw);
+    assert(is_none(&level));
+
+    Result_int res = OPTION_TO_RESULT(&bad, "not a digit", int);
+    assert(is_err(&res));
+
+    printf("✓ is_some is a compare against the sentinel\n");
+}
+
+void test_sentinel_matching() {
+    printf("Testing match() on sentinel niches...\n");
+
+    const char *input = "4x2";
+    int sum = 0, rejected = 0;
+    for (int i = 0; input[i]; i++) {
+        Option_int d = parse_digit(input[i]);
+        match(&d) {
+            when(Option_Some) { sum += d.Some; }
+            when(Option_None) { rejected++; }
+        }
+    }
+    assert(sum == 6 && rejected == 1);
+
+    Option_Color colors[] = { some_Color(COLOR_BLUE), none_Color(), some_Color(COLOR_RED) };
+    int picked = 0;
+    for (int i = 0; i < 3; i++) {
+        picked += let_strict(&colors[i]) in(
+            is(variant(Option_Some)) ? (colors[i].Some == COLOR_RED ? 1 : 10)
+            : is(variant(Option_None)) ? 100
+            : 1000
+        );
+    }
+    assert(picked == 111);
+
+    Option_Fd fd = some_Fd(5);
+    int got = 0;
+    match(&fd) {
+        when_bind(variant(Option_Some), Fd, f) { got = f; }
+        when(variant(Option_None)) { got = -1; }
+    }
+    assert(got == 5);
+
+    printf("✓ when(Option_Some) and variant() read the sentinel\n");
+}
+
+void test_user_niche_literals() {
+    printf("Testing literal Option_Some/Option_None on user-defined niches...\n");
+
+    // Payloads equal to Option_Some (1) and Option_None (2) must not be
+    // mistaken for a tag by auto mode
+    Option_Fd fds[] = { some_Fd(1), some_Fd(2), some_Fd(0), none_Fd() };
+    int arms[4];
+    for (int i = 0; i < 4; i++) {
+        arms[i] = 0;
+        match(&fds[i]) {
+            when(Option_Some) { arms[i] = 1; }
+            when(Option_None) { arms[i] = 2; }
+        }
+    }
+    assert(arms[0] == 1 && arms[1] == 1 && arms[2] == 1 && arms[3] == 2);
+
+    Option_Fd none_fd = none_Fd(), two = some_Fd(2);
+    assert(let(&none_fd) in(is(Option_None) ? 2 : is(Option_Some) ? 1 : 3) == 2);
+    assert(let(&two) in(is(Option_None) ? 2 : is(Option_Some) ? 1 : 3) == 1);
+
+    Option_Color blue = some_Color(COLOR_BLUE), no_color = none_Color();
+    assert(let(&blue) in(is(Option_Some) ? 1 : 0) == 1);
+    assert(let(&no_color) in(is(Option_None) ? 1 : 0) == 1);
+
+    Option_Level levels[] = { some_Level(2), none_Level() };
+    int seen = 0;
+    for (int i = 0; i < 2; i++) {
+        match(&levels[i]) {
+            when(Option_None) { seen += 10; }
+            otherwise { seen += 1; }
+        }
+    }
+    assert(seen == 11);
+
+    printf("✓ Literal tags on user niches compare against the sentinel\n");
+}
+
+int main() {
+    printf("Running sentinel niche tests...\n\n");
+
+    test_sentinel_layout();
+    test_sentinel_helpers();
+    test_sentinel_matching();
+    test_user_niche_literals();
+
+    printf("\n✅ All sentinel niche tests passed!\n");
+    return 0;
+}
@@ -143,11 +143,14 @@ int main() {
     Option_char_ptr name_some = get_name(1);
     Option_char_ptr name_none = get_name(999);
     
-    printf("name_some.tag = %u\n", name_some.tag);
-    if (name_some.tag == Option_Some) {
+    // Pointer options are niche-optimized: the pointer is the state
+    assert(sizeof(Option_char_ptr) == sizeof(char*));
+    printf("is_some(&name_some) = %d\n", is_some(&name_some));
+    if (is_some(&name_some)) {
         printf("name_some.Some = %p (\"%s\")\n", (void*)name_some.Some, name_some.Some);
     }
-    printf("name_none.tag = %u\n", name_none.tag);
+    printf("is_none(&name_none) = %d\n", is_none(&name_none));
+    assert(is_some(&name_some) && is_none(&name_none));
     
     printf("Testing manual variant matching for pointers:\n");
     match(&name_some) {
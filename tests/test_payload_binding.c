@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include "../match.h"
+
+// A payload that needs 16-byte alignment sits past VARIANT_UNION_OFFSET
+typedef struct { _Alignas(16) double lanes[2]; } Vec2;
+tag_union(Shape, Vec2, Point, int, Radius)
+
+void test_result_binding() {
+    printf("Testing when_bind on Result types...\n");
+
+    Result_double results[] = { ok_double(2.5), err_double("overflow") };
+    double sum = 0.0;
+    const char* last_error = NULL;
+    for (int i = 0; i < 2; i++) {
+        match(&results[i]) {
+            when_bind(variant(Result_Ok), double, value) { sum += value; }
+            when_bind(variant(Result_Err), char*, msg) { last_error = msg; }
+        }
+    }
+    assert(sum == 2.5);
+    assert(strcmp(last_error, "overflow") == 0);
+
+    // Bound locals are ordinary copies, scoped to their arm
+    Result_int r = ok_int(41);
+    int seen = 0;
+    match(&r) {
+        when_bind(variant(Result_Ok), int, n) { n++; seen = n; }
+        otherwise { seen = -1; }
+    }
+    assert(seen == 42 && r.Ok == 41);
+
+    printf("✓ Arms receive typed payload locals\n");
+}
+
+void test_it_expression() {
+    printf("Testing it(type) in let()...\n");
+
+    Result_int ok = ok_int(21);
+    Result_int err = err_int("bad");
+    assert(let(&ok) in(is(variant(Result_Ok)) ? it(int) * 2 : -1) == 42);
+    assert(let(&err) in(is(variant(Result_Ok)) ? it(int) * 2 : -1) == -1);
+
+    Option_int some = some_int(7);
+    assert(let(&some) in(is(variant(Option_Some)) ? it(int) : 0) == 7);
+
+    printf("✓ it(type) reads the payload through the subject pointer\n");
+}
+
+void test_offset_from_type() {
+    printf("Testing payload offsets beyond 8 bytes...\n");
+
+    assert(offsetof(Shape, _payload) == 16);
+
+    Shape p = new_Shape_Point((Vec2){{1.5, -3.0}});
+    Shape r = new_Shape_Radius(9);
+    double y = 0.0;
+    int radius = 0;
+    match(&p) {
+        when_bind(variant(Shape_Point), Vec2, v) { y = v.lanes[1]; }
+        when_bind(variant(Shape_Radius), int, n) { radius = n; }
+    }
+    match(&r) {
+        when_bind(variant(Shape_Point), Vec2, v) { y = v.lanes[0]; }
+        when_bind(variant(Shape_Radius), int, n) { radius = n; }
+    }
+    assert(y == -3.0);
+    assert(radius == 9);
+
+    printf("✓ offsetof follows the generated type's layout\n");
+}
+
+int main() {
+    printf("Running payload binding tests...\n\n");
+
+    test_result_binding();
+    test_it_expression();
+    test_offset_from_type();
+
+    printf("\n✅ All payload binding tests passed!\n");
+    return 0;
+}
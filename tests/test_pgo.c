@@ -0,0 +1,95 @@
+#include "pgo_hints.h"   // from pgo_profile.tsv; regenerate with: make tests/pgo_hints.h
+#include <stdio.h>
+#include <assert.h>
+#include "../match.h"
+
+#ifndef MATCH_HINTS
+#error "pgo_hints.h should define MATCH_HINTS"
+#endif
+
+// Hint compiled into the arm that ran last
+static int last_hint;
+
+// Mostly payload packets, some acks, rare control messages
+static int packet_class(int type, int len) {
+    int arm = -1;
+    match(type, len) {
+        when(0, __) { arm = 0; last_hint = MATCH_HINT_FOR(__LINE__); }
+        when(1, lt(64)) { arm = 1; last_hint = MATCH_HINT_FOR(__LINE__); }
+        when(__, ge(64)) { arm = 2; last_hint = MATCH_HINT_FOR(__LINE__); }
+        otherwise { arm = 3; last_hint = MATCH_HINT_FOR(__LINE__); }
+    }
+    return arm;
+}
+
+static int size_class(int n) {
+    return let(n) in(
+        is(lt(16)) ? (last_hint = MATCH_HINT_FOR(__LINE__), 0)
+        : is(lt(256)) ? (last_hint = MATCH_HINT_FOR(__LINE__), 1)
+        : (last_hint = MATCH_HINT_FOR(__LINE__), 2)
+    );
+}
+
+// Several arms on one line share a hint name, so the tool leaves them alone
+static int one_liner(int n) { return let(n) in(is(0) ? 0 : is(1) ? 1 : MATCH_HINT_FOR(__LINE__)); }
+
+// The workload pgo_profile.tsv was recorded from
+static void workload(void) {
+    for (int i = 0; i < 1000; i++) {
+        packet_class(i % 100 == 0 ? 0 : i % 10 == 0 ? 1 : 2, i % 10 == 0 ? 40 : 1500);
+        size_class(i % 50 == 0 ? 8 : i % 5 == 0 ? 100 : 4096);
+        one_liner(i % 3);
+    }
+}
+
+void test_hints_from_profile() {
+    printf("Testing hints generated from the recorded profile...\n");
+
+    // 10 control, 90 acks and 900 payload packets, tried in that order
+    assert(packet_class(0, 40) == 0 && last_hint == 10);    // 10 of 1000
+    assert(packet_class(1, 40) == 1 && last_hint == 91);    // 90 of 990
+    assert(packet_class(2, 1500) == 2 && last_hint == 1000); // 900 of 900
+    assert(packet_class(2, 40) == 3 && last_hint == -1);    // otherwise is never hinted
+
+    // 20 small, 180 medium, 800 large; the fallback is not an arm
+    assert(size_class(8) == 0 && last_hint == 20);
+    assert(size_class(100) == 1 && last_hint == 184);       // 180 of 980
+    assert(size_class(4096) == 2 && last_hint == -1);
+
+    assert(one_liner(2) == -1);
+
+    printf("✓ Per-arm probabilities follow first-match order\n");
+}
+
+void test_semantics_unchanged() {
+    printf("Testing that hinted arms match as before...\n");
+
+    for (int type = 0; type < 4; type++) {
+        for (int len = 0; len < 200; len += 7) {
+            int expected = type == 0 ? 0 : (type == 1 && len < 64) ? 1 : len >= 64 ? 2 : 3;
+            assert(packet_class(type, len) == expected);
+        }
+    }
+    for (int n = -5; n < 300; n++) assert(size_class(n) == (n < 16 ? 0 : n < 256 ? 1 : 2));
+    assert(one_liner(0) == 0 && one_liner(1) == 1);
+    workload();
+
+    printf("✓ Hints change code layout, not results\n");
+}
+
+int main() {
+#ifdef MATCH_PROFILE
+    // Recording build:
+    //   gcc -DMATCH_PROFILE -I. tests/test_pgo.c -o build/pgo_record
+    //   MATCH_PROFILE_OUT=tests/pgo_profile.tsv ./build/pgo_record
+    workload();
+    return 0;
+#endif
+    printf("Running profile-guided hint tests...\n\n");
+
+    test_hints_from_profile();
+    test_semantics_unchanged();
+
+    printf("\n✅ All profile-guided hint tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,192 @@
+#define _POSIX_C_SOURCE 200809L  // setenv
+#define MATCH_PROFILE
+#include <stdio.h>
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../match.h"
+
+static int classify(int x) {
+    int arm = -1;
+    match(x) {
+        when(0) { arm = 0; }
+        when(range(1, 10)) { arm = 1; }
+        when(gt(1000)) { arm = 2; }
+        otherwise { arm = 3; }
+    }
+    return arm;
+}
+
+static const char *grade(int score) {
+    return let(score) in(
+        is(ge(90)) ? "A"
+        : is(ge(80)) ? "B"
+        : "C"
+    );
+}
+
+static int opcode(int op) {
+    int r = 0;
+    match_switch(op) {
+        when_case(1) { r = 10; }
+        when_case(2, 3) { r = 20; }
+        otherwise { r = 30; }
+    }
+    return r;
+}
+
+// Seventy profiled arms ahead of a niche option: profiling must not use up
+// the layout slots the option's literal tags rely on
+#define ARMS10(b) \
+    when(b) { r = b; } when(b + 1) { r = b + 1; } when(b + 2) { r = b + 2; } when(b + 3) { r = b + 3; } \
+    when(b + 4) { r = b + 4; } when(b + 5) { r = b + 5; } when(b + 6) { r = b + 6; } when(b + 7) { r = b + 7; } \
+    when(b + 8) { r = b + 8; } when(b + 9) { r = b + 9; }
+
+static int seventy(int x) {
+    int r = -1;
+    match(x) {
+        ARMS10(0) ARMS10(10) ARMS10(20) ARMS10(30) ARMS10(40) ARMS10(50) ARMS10(60)
+    }
+    return r;
+}
+
+typedef int Fd;
+CreateOptionNiche(Fd, -1)
+
+static const MatchProfileArm *site_of(const char *func) {
+    for (const MatchProfileArm *a = __start_match_profile; a < __stop_match_profile; a++)
+        if (strcmp(a->func, func) == 0 && match_profile_is_site(a)) return a;
+    return NULL;
+}
+
+// Arms of a site in source order
+static size_t site_arms(const char *func, int kind_is, const MatchProfileArm **out, size_t max) {
+    size_t n = 0;
+    for (const MatchProfileArm *a = __start_match_profile; a < __stop_match_profile; a++) {
+        if (strcmp(a->func, func) != 0 || match_profile_is_site(a) || (strcmp(a->kind, "is") == 0) != kind_is) continue;
+        size_t k = n++;
+        while (k > 0 && out[k - 1]->order > a->order) { out[k] = out[k - 1]; k--; }
+        out[k] = a;
+        if (n == max) break;
+    }
+    return n;
+}
+
+void test_statement_arms() {
+    printf("Testing per-arm counts for match()...\n");
+
+    match_profile_reset();
+    for (int i = 0; i < 1000; i++) classify(i % 20);   // 0 x50, 2..9 x400, the rest x550
+    classify(5000);
+
+    const MatchProfileArm *arms[8];
+    size_t n = site_arms("classify", 0, arms, 8);
+    assert(n == 4);
+    assert(strcmp(arms[0]->kind, "when") == 0 && strcmp(arms[3]->kind, "otherwise") == 0);
+    assert(arms[0]->site_line == arms[3]->site_line && arms[0]->arm_line < arms[1]->arm_line);
+    assert(match_profile_count(arms[0]) == 50);
+    assert(match_profile_count(arms[1]) == 400);
+    assert(match_profile_count(arms[2]) == 1);
+    assert(match_profile_count(arms[3]) == 550);
+    assert(match_profile_count(site_of("classify")) == 1001);
+    assert(site_of("classify")->site_line == arms[0]->site_line);
+
+    printf("✓ Each when()/otherwise arm counts its own hits\n");
+}
+
+void test_expression_and_switch_arms() {
+    printf("Testing per-arm counts for let() and match_switch()...\n");
+
+    match_profile_reset();
+    int scores[] = { 95, 85, 70, 60, 91 };
+    for (int i = 0; i < 5; i++) grade(scores[i]);
+
+    const MatchProfileArm *arms[4];
+    size_t n = site_arms("grade", 1, arms, 4);
+    assert(n == 2);
+    assert(match_profile_count(arms[0]) == 2);
+    assert(match_profile_count(arms[1]) == 1);
+    // The two scores that fall through to "C" only show in the entry count
+    assert(match_profile_count(site_of("grade")) == 5);
+
+    for (int op = 0; op < 6; op++) opcode(op);
+    n = site_arms("opcode", 0, arms, 4);
+    assert(n == 3);
+    assert(match_profile_count(arms[0]) == 1);
+    assert(match_profile_count(arms[1]) == 2);
+    assert(match_profile_count(arms[2]) == 3);
+
+    printf("✓ is() and when_case() arms are counted too\n");
+}
+
+void test_dump_and_reset() {
+    printf("Testing match_profile_dump and match_profile_reset...\n");
+
+    match_profile_reset();
+    classify(0);
+    classify(0);
+
+    FILE *tmp = tmpfile();
+    assert(tmp);
+    match_profile_dump(tmp);
+    rewind(tmp);
+
+    char file[256], func[64], kind[16];
+    int site_line, index, arm_line, records = 0, found = 0;
+    unsigned long long hits;
+    while (fscanf(tmp, "%255[^\t]\t%63[^\t]\t%d\t%d\t%15[^\t]\t%d\t%llu\n",
+                  file, func, &site_line, &index, kind, &arm_line, &hits) == 7) {
+        records++;
+        if (strcmp(func, "classify") == 0 && index == -1) {
+            assert(strcmp(kind, "site") == 0 && hits == 2);
+        }
+        if (strcmp(func, "classify") == 0 && index == 0) {
+            assert(strstr(file, "test_profile.c") && strcmp(kind, "when") == 0 && hits == 2);
+            found = 1;
+        }
+        if (strcmp(func, "grade") == 0) assert(hits == 0);
+    }
+    fclose(tmp);
+    assert(found && records == (int)(__stop_match_profile - __start_match_profile));
+
+    match_profile_reset();
+    const MatchProfileArm *arms[4];
+    site_arms("classify", 0, arms, 4);
+    assert(match_profile_count(arms[0]) == 0);
+
+    printf("✓ Dump lists every arm, including ones never hit\n");
+}
+
+void test_layout_slots() {
+    printf("Testing niche literals after many profiled arms...\n");
+
+    assert(seventy(69) == 69 && seventy(70) == -1);
+    Option_Fd open = some_Fd(3), closed = none_Fd();
+    assert(let(&open) in(is(Option_Some) ? 1 : is(Option_None) ? 2 : 0) == 1);
+    assert(let(&closed) in(is(Option_Some) ? 1 : is(Option_None) ? 2 : 0) == 2);
+
+    printf("✓ Profiled arms leave the layout slots alone\n");
+}
+
+int main() {
+    printf("Running arm-hit profiling tests...\n\n");
+
+    test_statement_arms();
+    test_expression_and_switch_arms();
+    test_dump_and_reset();
+    test_layout_slots();
+
+    printf("\n");
+    for (int i = 0; i < 100; i++) {
+        classify(i);
+        grade(i);
+        opcode(i % 4);
+    }
+    match_profile_report(stdout);
+
+    // Keep the exit-time dump out of the test output
+    setenv("MATCH_PROFILE_OUT", "/dev/null", 1);
+
+    printf("\n✅ All arm-hit profiling tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include "../match.h"
+
+typedef enum { Parse_Empty = 1, Parse_BadDigit, Parse_Overflow } ParseError;
+typedef uint8_t Status;
+
+CreateResultCode(int, ParseError)
+CreateResultCode(short, Status)
+
+static Result_int_ParseError parse_number(const char* text) {
+    if (*text == '\0') return err_int_ParseError(Parse_Empty);
+    int value = 0;
+    for (; *text; text++) {
+        if (*text < '0' || *text > '9') return err_int_ParseError(Parse_BadDigit);
+        if (value > 100000) return err_int_ParseError(Parse_Overflow);
+        value = value * 10 + (*text - '0');
+    }
+    return ok_int_ParseError(value);
+}
+
+static Result_int_ErrorCode checked_index(const int* values, int n, int i) {
+    return (i >= 0 && i < n) ? ok_int_ErrorCode(values[i]) : err_int_ErrorCode(Error_OutOfBounds);
+}
+
+static int twice(int x) { return x * 2; }
+
+void test_code_layout() {
+    printf("Testing error-code Result layout...\n");
+
+    _Static_assert(sizeof(Result_int_ErrorCode) == 8, "tag + int, no pointer");
+    _Static_assert(sizeof(Result_int_ParseError) == 8, "tag + int, no pointer");
+    _Static_assert(sizeof(Result_short_Status) == 8, "tag + short");
+    _Static_assert(sizeof(Result_double_ErrorCode) == 16, "tag + double");
+    _Static_assert(sizeof(Result_int) == 16, "message Results keep their char*");
+
+    printf("✓ Result_int_ErrorCode is %zu bytes (Result_int is %zu)\n",
+           sizeof(Result_int_ErrorCode), sizeof(Result_int));
+}
+
+void test_code_helpers() {
+    printf("Testing helpers on error-code Results...\n");
+
+    Result_int_ParseError ok = parse_number("1234");
+    Result_int_ParseError bad = parse_number("12x4");
+    assert(is_ok(&ok) && ok.Ok == 1234);
+    assert(is_err(&bad) && bad.Err == Parse_BadDigit);
+    assert(unwrap_or(&bad, -1) == -1);
+
+    Result_int_ParseError doubled = RESULT_MAP(&ok, twice, int_ParseError);
+    assert(is_ok(&doubled) && doubled.Ok == 2468);
+    Result_int_ParseError still_bad = RESULT_MAP(&bad, twice, int_ParseError);
+    assert(is_err(&still_bad) && still_bad.Err == Parse_BadDigit);
+
+    const int values[] = { 3, 1, 4 };
+    Result_int_ErrorCode out = checked_index(values, 3, 7);
+    assert(is_err(&out) && out.Err == Error_OutOfBounds);
+    assert(strcmp(error_message(out.Err), ERR_OUT_OF_BOUNDS) == 0);
+    assert(strcmp(error_message(Error_Timeout), ERR_TIMEOUT) == 0);
+
+    Option_int none = none_int();
+    Result_int_ErrorCode missing = OPTION_TO_RESULT(&none, Error_NullPointer, int_ErrorCode);
+    assert(is_err(&missing) && missing.Err == Error_NullPointer);
+
+    printf("✓ is_ok, unwrap_or, RESULT_MAP and OPTION_TO_RESULT carry codes\n");
+}
+
+void test_code_matching() {
+    printf("Testing match() on error-code Results...\n");
+
+    const char* inputs[] = { "42", "", "4a", "9999999" };
+    const int expected[] = { 42, -1, -2, -3 };
+    for (int i = 0; i < 4; i++) {
+        Result_int_ParseError r = parse_number(inputs[i]);
+        int got = 0;
+        match(&r) {
+            when(Result_Ok) { got = r.Ok; }
+            when(Result_Err) { got = -(int)r.Err; }
+        }
+        assert(got == expected[i]);
+
+        int again = let_strict(&r) in(
+            is(variant(Result_Ok)) ? it(int) : -(int)it(ParseError)
+        );
+        assert(again == expected[i]);
+    }
+
+    Result_short_Status st = err_short_Status(200);
+    match(&st) {
+        when_bind(variant(Result_Err), Status, code) { assert(code == 200); }
+        otherwise { assert(0 && "expected an error"); }
+    }
+
+    printf("✓ Ok and Err arms see the value and the code\n");
+}
+
+int main() {
+    printf("Running error-code Result tests...\n\n");
+
+    test_code_layout();
+    test_code_helpers();
+    test_code_matching();
+
+    printf("\n✅ All error-code Result tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include "../match.h"
+
+typedef struct { int x, y; } Point;
+CreateResult(Point)
+CreateOption(Point)
+
+static int lookups = 0;
+static int fallbacks = 0;
+
+// Both return a pointer to a cache slot, refilled on every call
+static Result_int* lookup(int key) {
+    static Result_int slot;
+    lookups++;
+    slot = key >= 0 ? ok_int(key * 10) : err_int(ERR_INVALID_INPUT);
+    return &slot;
+}
+
+static Option_int* find(int key) {
+    static Option_int slot;
+    lookups++;
+    slot = key >= 0 ? some_int(key + 1) : none_int();
+    return &slot;
+}
+
+static int fallback(void) {
+    fallbacks++;
+    return -1;
+}
+
+static int on_error(char* msg) {
+    (void)msg;
+    fallbacks++;
+    return -2;
+}
+
+static int twice(int x) { return x * 2; }
+static int is_even(int x) { return x % 2 == 0; }
+static Result_int halve(int x) { return x % 2 ? err_int("odd") : ok_int(x / 2); }
+static Option_int decrement(int x) { return x > 0 ? some_int(x - 1) : none_int(); }
+
+void test_result_helpers_evaluate_once() {
+    printf("Testing Result helpers evaluate their argument once...\n");
+
+    lookups = fallbacks = 0;
+    assert(unwrap_or(lookup(4), 0) == 40);
+    assert(lookups == 1);
+
+    // The default is evaluated only when it is used
+    assert(unwrap_or(lookup(4), fallback()) == 40);
+    assert(fallbacks == 0);
+    assert(unwrap_or(lookup(-1), fallback()) == -1);
+    assert(lookups == 3 && fallbacks == 1);
+
+    assert(unwrap_or_else(lookup(-1), on_error) == -2);
+    assert(lookups == 4 && fallbacks == 2);
+
+    Result_int mapped = RESULT_MAP(lookup(2), twice, int);
+    assert(is_ok(&mapped) && mapped.Ok == 40 && lookups == 5);
+
+    Result_int chained = RESULT_AND_THEN(lookup(3), halve);
+    assert(is_ok(&chained) && chained.Ok == 15 && lookups == 6);
+
+    Option_int opt = RESULT_TO_OPTION(lookup(1), int);
+    assert(is_some(&opt) && opt.Some == 10 && lookups == 7);
+
+    Result_int held = *lookup(5);
+    Result_int* cursor = &held;
+    const int* ref = as_ref(cursor++);
+    assert(ref == &held.Ok && cursor == &held + 1);
+
+    printf("✓ unwrap_or, RESULT_MAP, RESULT_AND_THEN and RESULT_TO_OPTION call lookup() once\n");
+}
+
+void test_option_helpers_evaluate_once() {
+    printf("Testing Option helpers evaluate their argument once...\n");
+
+    lookups = fallbacks = 0;
+    assert(unwrap_option_or(find(4), 0) == 5);
+    assert(unwrap_option_or_else(find(-1), fallback) == -1);
+    assert(lookups == 2 && fallbacks == 1);
+
+    Option_int mapped = OPTION_MAP(find(2), twice, int);
+    assert(is_some(&mapped) && mapped.Some == 6 && lookups == 3);
+
+    Option_int kept = OPTION_FILTER(find(3), is_even);
+    Option_int dropped = OPTION_FILTER(find(4), is_even);
+    assert(is_some(&kept) && kept.Some == 4 && is_none(&dropped) && lookups == 5);
+
+    Option_int next = OPTION_AND_THEN(find(0), decrement);
+    assert(is_some(&next) && next.Some == 0 && lookups == 6);
+
+    Result_int res = OPTION_TO_RESULT(find(-3), ERR_NULL_POINTER, int);
+    assert(is_err(&res) && lookups == 7);
+
+    Option_int items[3] = { some_int(1), none_int(), some_int(3) };
+    Option_int* it = items;
+    int total = 0;
+    while (it < items + 3) total += unwrap_option_or(it++, 100);
+    assert(total == 104);
+
+    printf("✓ Option helpers advance it++ once per call\n");
+}
+
+void test_helpers_stay_generic() {
+    printf("Testing helpers on struct payloads and const pointers...\n");
+
+    const Result_Point cr = ok_Point((Point){ 1, 2 });
+    Point origin = { 0, 0 };
+    Point p = unwrap_or(&cr, origin);
+    assert(p.x == 1 && p.y == 2);
+
+    const Option_Point co = none_Point();
+    Point q = unwrap_option_or(&co, origin);
+    assert(q.x == 0 && q.y == 0);
+    assert(option_as_ref(&co) == NULL);
+
+    // Nested helpers each get their own temporary
+    Result_int a = err_int("a"), b = ok_int(7);
+    assert(unwrap_or(&a, unwrap_or(&b, 0)) == 7);
+
+    // Mixed arithmetic types convert as the ?: they replace did
+    Result_double d = err_double("x");
+    double v = unwrap_or(&d, 1);
+    assert(v == 1.0);
+
+    printf("✓ Helpers keep their types and nest\n");
+}
+
+int main() {
+    printf("Running single-evaluation helper tests...\n\n");
+
+    test_result_helpers_evaluate_once();
+    test_option_helpers_evaluate_once();
+    test_helpers_stay_generic();
+
+    printf("\n✅ All single-evaluation helper tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * Test file for strict dispatch mode
+ *
+ * MATCH_STRICT makes every match/let in this file strict: integer subjects are
+ * never dereferenced and only variant(tag) reads a tag. match_auto()/let_auto()
+ * opt individual sites back into the auto-variant behaviour.
+ */
+
+#define MATCH_STRICT
+#include "../match.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+int main() {
+    printf("=== Testing Strict Dispatch Mode ===\n\n");
+    
+    // Test 1: Large integer subjects are compared, never dereferenced
+    printf("Test 1: Integer subjects above the pointer heuristic threshold...\n");
+    int big = 5000;
+    int result = 0;
+    match(big) {
+        when(42) { result = 1; }
+        when(5000) { result = 2; }
+        otherwise { result = 3; }
+    }
+    assert(result == 2);
+    
+    long huge = 0x7FFFFFFFL;
+    assert((let(huge) in(is(7) ? 1 : is(0x7FFFFFFFL) ? 2 : 0)) == 2);
+    printf("✓ Integer subjects match by value only\n\n");
+    
+    // Test 2: variant(tag) goes straight to the tag compare
+    printf("Test 2: Explicit variant dispatch...\n");
+    Result_int ok = ok_int(7);
+    Result_int err = err_int("bad");
+    match(&ok) {
+        when(variant(Result_Err)) { result = -1; }
+        when(variant(Result_Ok)) { result = ok.Ok; }
+        otherwise { result = 0; }
+    }
+    assert(result == 7);
+    
+    const char* kind = let(&err) in(
+        is(variant(Result_Ok)) ? "ok"
+        : is(variant(Result_Err)) ? "err"
+        : "unknown"
+    );
+    assert(strcmp(kind, "err") == 0);
+    printf("✓ variant() patterns work in strict mode\n\n");
+    
+    // Test 3: Plain literals do not auto-convert to variants in strict mode
+    printf("Test 3: No speculative tag reads for literals...\n");
+    Option_int some = some_int(3);
+    match(&some) {
+        when(Option_Some) { result = 1; }
+        otherwise { result = 0; }
+    }
+    assert(result == 0);
+    printf("✓ Literal patterns compare the subject value\n\n");
+    
+    // Test 4: Auto mode can still be selected per site
+    printf("Test 4: match_auto/let_auto...\n");
+    match_auto(&some) {
+        when(Option_Some) { result = some.Some; }
+        when(Option_None) { result = -1; }
+    }
+    assert(result == 3);
+    assert((let_auto(&some) in(is(Option_Some) ? 1 : 0)) == 1);
+    printf("✓ Auto mode is available per site\n\n");
+    
+    // Test 5: Strict sites mixed with auto sites in the same scope
+    printf("Test 5: Nested strict and auto sites...\n");
+    Option_int none = none_int();
+    match_auto(&none) {
+        when(Option_None) {
+            match_strict(big) {
+                when(gt(4096)) { result = 10; }
+                otherwise { result = 11; }
+            }
+        }
+        otherwise { result = 12; }
+    }
+    assert(result == 10);
+    printf("✓ Nested sites keep their own mode\n\n");
+    
+    printf("=== All Strict Mode Tests Passed! ===\n");
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include "../match.h"
+
+enum { M_GET, M_HEAD, M_POST, M_PUT, M_DELETE, M_OPTIONS, M_UNKNOWN };
+
+static int http_method(const char *m) {
+    return let(m) in(
+        is(str("GET")) ? M_GET
+        : is(str("HEAD")) ? M_HEAD
+        : is(str("POST")) ? M_POST
+        : is(str("PUT")) ? M_PUT
+        : is(str("DELETE")) ? M_DELETE
+        : is(str("OPTIONS")) ? M_OPTIONS
+        : M_UNKNOWN
+    );
+}
+
+void test_cstring_subjects() {
+    printf("Testing str() on char * subjects...\n");
+
+    assert(http_method("GET") == M_GET);
+    assert(http_method("HEAD") == M_HEAD);
+    assert(http_method("POST") == M_POST);
+    assert(http_method("PUT") == M_PUT);
+    assert(http_method("DELETE") == M_DELETE);
+    assert(http_method("OPTIONS") == M_OPTIONS);
+
+    // Prefixes, extensions, case and the empty string don't match
+    assert(http_method("GE") == M_UNKNOWN);
+    assert(http_method("GETS") == M_UNKNOWN);
+    assert(http_method("get") == M_UNKNOWN);
+    assert(http_method("") == M_UNKNOWN);
+    assert(http_method(NULL) == M_UNKNOWN);
+
+    // Subjects held in writable buffers
+    char buf[16];
+    strcpy(buf, "DELETE");
+    assert(http_method(buf) == M_DELETE);
+
+    int empty = 0;
+    match("") {
+        when(str("")) { empty = 1; }
+        otherwise { empty = 2; }
+    }
+    assert(empty == 1);
+
+    // Short literals are compared byte by byte and stop at the subject's
+    // terminator, so a shorter string in an exactly-sized buffer is safe
+    char tight[2] = { '4', 0 };
+    assert(let(tight) in(is(str("42")) ? 1 : 0) == 0);
+    assert(let("42") in(is(str("")) ? 1 : is(str("42")) ? 2 : 0) == 2);
+    assert(let("420") in(is(str("42")) ? 1 : 0) == 0);
+    assert(let("OPTIONS") in(is(str("OPTIONZ")) ? 1 : 0) == 0);
+
+    printf("✓ Literal arms match whole strings only\n");
+}
+
+void test_long_literals() {
+    printf("Testing literals longer than one word...\n");
+
+    const char *names[] = { "content-type", "content-length", "content-encoding",
+                            "content-typf", "content-type2", "accept" };
+    int expected[] = { 0, 1, 2, 3, 3, 3 };
+    for (int i = 0; i < 6; i++) {
+        int header = 3;
+        match(names[i]) {
+            when(str("content-type")) { header = 0; }
+            when(str("content-length")) { header = 1; }
+            when(str("content-encoding")) { header = 2; }
+        }
+        assert(header == expected[i]);
+    }
+
+    // Same first 8 bytes, difference in the tail only
+    assert(let("abcdefghX") in(is(str("abcdefghY")) ? 1 : 0) == 0);
+    assert(let("abcdefghY") in(is(str("abcdefghY")) ? 1 : 0) == 1);
+
+    printf("✓ Word compare and memcmp tail agree with strcmp\n");
+}
+
+void test_string_views() {
+    printf("Testing str_view() subjects...\n");
+
+    // Tokens inside a request line, not NUL-terminated
+    const char *line = "POST /index.html HTTP/1.1";
+    const char *space = strchr(line, ' ');
+    int method = let(str_view(line, space - line)) in(
+        is(str("GET")) ? M_GET
+        : is(str("POST")) ? M_POST
+        : M_UNKNOWN
+    );
+    assert(method == M_POST);
+
+    // A view of the first three bytes of "POST" is "POS", not "POST"
+    assert(let(str_view(line, 3)) in(is(str("POST")) ? 1 : is(str("POS")) ? 2 : 0) == 2);
+    assert(let(str_view(line, 0)) in(is(str("")) ? 1 : 0) == 1);
+
+    // Mixed with integer columns
+    int version = 11;
+    int route = let_strict(str_view(line, 4), version) in(
+        is(str("POST"), 10) ? 1
+        : is(str("POST"), 11) ? 2
+        : is(__, __) ? 3
+        : 0
+    );
+    assert(route == 2);
+
+    printf("✓ Views compare exactly len bytes\n");
+}
+
+int main() {
+    printf("Running string pattern tests...\n\n");
+
+    test_cstring_subjects();
+    test_long_literals();
+    test_string_views();
+
+    printf("\n✅ All string pattern tests passed!\n");
+    return 0;
+}
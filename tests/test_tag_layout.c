@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include "../match.h"
+
+// Hand-rolled compact layouts: the tag is read with the width and offset of
+// the subject's own tag member
+typedef struct __attribute__((packed)) {
+    double value;
+    uint8_t tag;
+} PackedReading;
+
+typedef struct {
+    uint16_t tag;
+    uint16_t port;
+} SmallMsg;
+
+enum { READING_OK = 1, READING_STALE = 2, MSG_PING = 7, MSG_DATA = 300 };
+
+// Over-aligned payload: the union starts a full cache line after the tag
+typedef struct { _Alignas(64) float lanes[16]; } Line;
+
+tag_union(Block,
+    Line, Data,
+    int, Empty
+)
+
+void test_layout_metadata() {
+    printf("Testing per-type layout metadata...\n");
+
+    _Static_assert(match_tag_offset(Result_int) == 0, "tag leads Result");
+    _Static_assert(match_tag_width(Result_int) == 4, "uint32_t tag");
+    _Static_assert(match_payload_offset(Result_int) == VARIANT_UNION_OFFSET, "classic layout");
+    _Static_assert(match_payload_offset(Option_double) == 8, "classic layout");
+    _Static_assert(match_payload_offset(Block) == 64, "payload on its own cache line");
+
+    assert(MATCH_TAG_OFFSET(MATCH_TAG_LAYOUT((PackedReading*)0)) == 8);
+    assert(MATCH_TAG_WIDTH(MATCH_TAG_LAYOUT((PackedReading*)0)) == 1);
+    assert(MATCH_TAG_WIDTH(MATCH_TAG_LAYOUT((SmallMsg*)0)) == 2);
+
+    printf("✓ Generated types report tag offset, width and payload offset\n");
+}
+
+void test_compact_subjects() {
+    printf("Testing variant() on compact layouts...\n");
+
+    PackedReading readings[] = { { 21.5, READING_OK }, { -1.0, READING_STALE } };
+    assert(sizeof(PackedReading) == 9);
+    double sum = 0;
+    int stale = 0;
+    for (int i = 0; i < 2; i++) {
+        match(&readings[i]) {
+            when(variant(READING_OK)) { sum += readings[i].value; }
+            when(variant(READING_STALE)) { stale++; }
+        }
+    }
+    assert(sum == 21.5 && stale == 1);
+
+    // Only the low 16 bits are the tag; the port must not leak into the compare
+    SmallMsg msg = { MSG_DATA, 8080 };
+    assert(let(&msg) in(is(variant(MSG_PING)) ? 1 : is(variant(MSG_DATA)) ? 2 : 0) == 2);
+    msg.tag = MSG_PING;
+    assert(let_strict(&msg) in(is(variant(MSG_PING)) ? 1 : 0) == 1);
+
+    printf("✓ Packed and 16-bit tags match without touching the payload\n");
+}
+
+void test_over_aligned_payload() {
+    printf("Testing over-aligned payloads...\n");
+
+    Line line;
+    for (int i = 0; i < 16; i++) line.lanes[i] = (float)i;
+    Block blocks[] = { new_Block_Data(line), new_Block_Empty(3) };
+
+    float last = 0;
+    int empty = 0;
+    for (int i = 0; i < 2; i++) {
+        match(&blocks[i]) {
+            when_bind(variant(Block_Data), Line, l) { last = l.lanes[15]; }
+            when_bind(variant(Block_Empty), int, n) { empty = n; }
+        }
+    }
+    assert(last == 15.0f && empty == 3);
+
+    // Patterns built outside a match site keep the classic layout
+    MatchPattern p = variant(Block_Empty);
+    assert(MATCH_TAG_OFFSET(p.hi) == 0 && MATCH_TAG_WIDTH(p.hi) == 4);
+    assert(evaluate_pattern((intptr_t)&blocks[1], p));
+    assert(!evaluate_pattern((intptr_t)&blocks[0], p));
+
+    printf("✓ Payloads aligned past VARIANT_UNION_OFFSET bind correctly\n");
+}
+
+int main() {
+    printf("Running tag layout tests...\n\n");
+
+    test_layout_metadata();
+    test_compact_subjects();
+    test_over_aligned_payload();
+
+    printf("\n✅ All tag layout tests passed!\n");
+    return 0;
+}
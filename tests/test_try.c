@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include "../match.h"
+
+typedef struct { int x, y; } Point;
+CreateResult(Point)
+
+static int calls = 0;
+
+static Result_int parse_int(const char* text) {
+    calls++;
+    if (text == NULL || *text == '\0') return err_int("Empty string");
+    int value = 0;
+    for (; *text; text++) {
+        if (*text < '0' || *text > '9') return err_int("Invalid number");
+        value = value * 10 + (*text - '0');
+    }
+    return ok_int(value);
+}
+
+static Result_int positive(int value) {
+    return value > 0 ? ok_int(value) : err_int("Not positive");
+}
+
+static Result_int sum_positive(const char* a, const char* b) {
+    return ok_int(TRY(positive(TRY(parse_int(a)))) + TRY(positive(TRY(parse_int(b)))));
+}
+
+static Result_Point parse_point(const char* x, const char* y) {
+    return ok_Point((Point){ TRY_OR(parse_int(x), err_Point), TRY_OR(parse_int(y), err_Point) });
+}
+
+static Result_long_ErrorCode widen(Result_int_ErrorCode r) {
+    return ok_long_ErrorCode((long)TRY_OR(r, err_long_ErrorCode) << 32);
+}
+
+static Result_int_ErrorCode to_code(const char* msg) {
+    (void)msg;
+    return err_int_ErrorCode(Error_InvalidInput);
+}
+
+static Result_int_ErrorCode parse_code(const char* text) {
+    return ok_int_ErrorCode(TRY_OR(parse_int(text), to_code));
+}
+
+void test_try_propagation() {
+    printf("Testing TRY() propagation...\n");
+
+    Result_int r = sum_positive("12", "30");
+    assert(is_ok(&r) && r.Ok == 42);
+
+    r = sum_positive("12", "3x");
+    assert(is_err(&r) && strcmp(r.Err, "Invalid number") == 0);
+
+    r = sum_positive("0", "30");
+    assert(is_err(&r) && strcmp(r.Err, "Not positive") == 0);
+
+    printf("✓ TRY() yields Ok values and returns the first Err\n");
+}
+
+void test_try_single_evaluation() {
+    printf("Testing TRY() evaluates its argument once...\n");
+
+    calls = 0;
+    Result_int r = sum_positive("5", "6");
+    assert(is_ok(&r) && calls == 2);
+
+    // The second parse never runs once the first one fails
+    calls = 0;
+    r = sum_positive("", "6");
+    assert(is_err(&r) && calls == 1);
+
+    printf("✓ Each Result is evaluated once and later steps are skipped\n");
+}
+
+void test_try_or_conversion() {
+    printf("Testing TRY_OR() error conversion...\n");
+
+    Result_Point p = parse_point("3", "4");
+    assert(is_ok(&p) && p.Ok.x == 3 && p.Ok.y == 4);
+
+    p = parse_point("3", "");
+    assert(is_err(&p) && strcmp(p.Err, "Empty string") == 0);
+
+    Result_long_ErrorCode w = widen(ok_int_ErrorCode(1));
+    assert(is_ok(&w) && w.Ok == 1L << 32);
+    w = widen(err_int_ErrorCode(Error_Timeout));
+    assert(is_err(&w) && w.Err == Error_Timeout);
+
+    Result_int_ErrorCode c = parse_code("77");
+    assert(is_ok(&c) && c.Ok == 77);
+    c = parse_code("seven");
+    assert(is_err(&c) && c.Err == Error_InvalidInput);
+
+    printf("✓ Errors cross Result types through err_TYPE and custom mappers\n");
+}
+
+int main() {
+    printf("Running TRY() tests...\n\n");
+
+    test_try_propagation();
+    test_try_single_evaluation();
+    test_try_or_conversion();
+
+    printf("\n✅ All TRY() tests passed!\n");
+    return 0;
+}
@@ -28,5 +28,22 @@ int main() {
     printf("*(double*)((char*)&res_ok + VARIANT_UNION_OFFSET) = %f\n", *ok_ptr);
     printf("*(char**)((char*)&res_err + VARIANT_UNION_OFFSET) = %s\n", *err_ptr);
     
+    // variant_value() reads the same payload through the match site's subject
+    Result_double* results[] = { &res_ok, &res_err };
+    double ok_value = 0.0;
+    const char* err_value = NULL;
+    for (int i = 0; i < 2; i++) {
+        match_strict(results[i]) {
+            when(variant(Result_Ok)) { ok_value = variant_value(double); }
+            when(variant(Result_Err)) { err_value = variant_value(char*); }
+        }
+    }
+    assert(ok_value == 3.14);
+    assert(strcmp(err_value, "Math error") == 0);
+    
+    double doubled = let_strict(&res_ok) in(is(variant(Result_Ok)) ? variant_value(double) * 2 : 0.0);
+    assert(doubled == 6.28);
+    printf("variant_value(double) = %f, variant_value(char*) = %s\n", ok_value, err_value);
+    
     return 0;
 }
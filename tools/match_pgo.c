@@ -0,0 +1,330 @@
+/*
+ * match_pgo - turn recorded arm hits into branch hints for match.h
+ *
+ * A MATCH_PROFILE build writes one record per site and per arm to
+ * $MATCH_PROFILE_OUT (see match_profile_dump in match.h):
+ *
+ *   file  function  site_line  arm_index  kind  arm_line  hits
+ *
+ * Blank lines and lines starting with # are skipped.
+ *
+ * Arms of a site are tried in order and the first one that matches wins, so
+ * arm k is only tested on the runs that none of arms 0..k-1 took. This tool
+ * sums the records of one or more runs, works out for every when()/is() arm
+ * how often it holds when it is tested:
+ *
+ *   p(k) = hits(k) / (entries - hits(0) - ... - hits(k-1))
+ *
+ * and writes a header with one hint per arm line:
+ *
+ *   #define MATCH_HINTS
+ *   #define MATCH_HINT_L44 ~, 963
+ *
+ * Included before match.h in the profiled source, each hinted arm tests its
+ * patterns through __builtin_expect_with_probability(..., 0.963). Arm order
+ * is never changed: moving an arm up is only correct when no earlier arm
+ * overlaps it, which the profile cannot tell. Instead, each site whose arms
+ * are not already hottest-first gets a comment with the suggested order.
+ *
+ * otherwise and when_case() arms get no hint: otherwise always holds once
+ * reached, and a switch dispatches through its jump table. Arms tested fewer
+ * than -m times (default 100) get none either, and neither does a line
+ * holding more than one arm, since a hint is looked up by line number.
+ *
+ * Usage: match_pgo profile.tsv [more.tsv ...] [-s source.c] [-m min] [-o hints.h]
+ *
+ * -s keeps the records whose file ends in source.c; it is required when the
+ * profile covers more than one file.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_LINE 4096
+#define MAX_INPUTS 64
+
+typedef struct {
+    char *file;
+    char *func;
+    char *kind;
+    int site_line;
+    int index;             // -1 for the site's own record
+    int arm_line;
+    unsigned long long hits;
+} Record;
+
+typedef struct {
+    const Record *arm;
+    unsigned long long reach;   // runs that tested the arm
+    int permille;
+    int shared;                 // another hinted arm is on the same line
+} Hint;
+
+static Record *records;
+static int nrecords, cap_records;
+static Hint *hints;
+static int nhints;
+
+static void die(const char *msg) {
+    fprintf(stderr, "match_pgo: %s\n", msg);
+    exit(1);
+}
+
+static char *dup_string(const char *s) {
+    size_t n = strlen(s) + 1;
+    char *d = malloc(n);
+    if (!d) die("out of memory");
+    return memcpy(d, s, n);
+}
+
+// ============================================================================
+// Reading Profiles
+// ============================================================================
+
+// Splits a record at tabs; returns 0 unless it has exactly seven fields
+static int split_record(char *line, char **fields) {
+    int n = 0;
+    line[strcspn(line, "\r\n")] = '\0';
+    for (char *p = line; n < 7; n++) {
+        fields[n] = p;
+        char *tab = strchr(p, '\t');
+        if (!tab) return n == 6;
+        *tab = '\0';
+        p = tab + 1;
+    }
+    return 0;
+}
+
+static int parse_int(const char *s, long long *out) {
+    char *end;
+    *out = strtoll(s, &end, 10);
+    return end != s && *end == '\0';
+}
+
+static void read_profile(const char *name) {
+    FILE *in = fopen(name, "r");
+    if (!in) { perror(name); exit(1); }
+    char line[MAX_LINE];
+    int line_no = 0;
+    while (fgets(line, sizeof line, in)) {
+        line_no++;
+        if (line[0] == '\n' || line[0] == '#') continue;
+        char *f[7];
+        long long site_line, index, arm_line, hits;
+        if (!split_record(line, f) || !parse_int(f[2], &site_line) || !parse_int(f[3], &index) ||
+            !parse_int(f[5], &arm_line) || !parse_int(f[6], &hits) || hits < 0) {
+            fprintf(stderr, "%s:%d: ", name, line_no);
+            die("expected file, function, site_line, arm_index, kind, arm_line, hits");
+        }
+        if (nrecords == cap_records) {
+            cap_records = cap_records ? cap_records * 2 : 256;
+            records = realloc(records, cap_records * sizeof *records);
+            if (!records) die("out of memory");
+        }
+        records[nrecords++] = (Record){ dup_string(f[0]), dup_string(f[1]), dup_string(f[4]),
+                                        (int)site_line, (int)index, (int)arm_line, (unsigned long long)hits };
+    }
+    fclose(in);
+}
+
+static int same_site(const Record *a, const Record *b) {
+    return a->site_line == b->site_line && strcmp(a->file, b->file) == 0 && strcmp(a->func, b->func) == 0;
+}
+
+// Site order: file, site line, function; the site record, then its arms
+static int compare_records(const void *pa, const void *pb) {
+    const Record *a = pa, *b = pb;
+    int c = strcmp(a->file, b->file);
+    if (c == 0) c = (a->site_line > b->site_line) - (a->site_line < b->site_line);
+    if (c == 0) c = strcmp(a->func, b->func);
+    if (c == 0) c = (a->index > b->index) - (a->index < b->index);
+    return c;
+}
+
+// Sorts the records and adds up the ones several runs have in common
+static void merge_records(void) {
+    qsort(records, nrecords, sizeof *records, compare_records);
+    int n = 0;
+    for (int i = 0; i < nrecords; i++) {
+        Record *last = n > 0 ? &records[n - 1] : NULL;
+        if (last && compare_records(last, &records[i]) == 0) {
+            if (last->arm_line != records[i].arm_line || strcmp(last->kind, records[i].kind) != 0)
+                die("profiles disagree about an arm; were they recorded from the same source?");
+            last->hits += records[i].hits;
+        } else {
+            records[n++] = records[i];
+        }
+    }
+    nrecords = n;
+}
+
+static int ends_with_path(const char *file, const char *suffix) {
+    size_t lf = strlen(file), ls = strlen(suffix);
+    if (ls > lf || strcmp(file + lf - ls, suffix) != 0) return 0;
+    return lf == ls || file[lf - ls - 1] == '/' || suffix[0] == '/';
+}
+
+// Keeps the records of one source file
+static void select_source(const char *suffix) {
+    int n = 0;
+    for (int i = 0; i < nrecords; i++) {
+        if (suffix ? ends_with_path(records[i].file, suffix) : strcmp(records[i].file, records[0].file) == 0)
+            records[n++] = records[i];
+        else if (!suffix)
+            die("profile covers several source files; pick one with -s");
+    }
+    nrecords = n;
+    if (n > 0 && strcmp(records[0].file, records[n - 1].file) != 0)
+        die("-s matches several source files; give more of the path");
+}
+
+// ============================================================================
+// Computing Hints
+// ============================================================================
+
+static int hintable(const Record *r) {
+    return strcmp(r->kind, "when") == 0 || strcmp(r->kind, "is") == 0;
+}
+
+static void add_hint(const Record *arm, unsigned long long reach) {
+    hints = realloc(hints, (nhints + 1) * sizeof *hints);
+    if (!hints) die("out of memory");
+    int permille = (int)((arm->hits * 1000 + reach / 2) / reach);
+    hints[nhints++] = (Hint){ arm, reach, permille > 1000 ? 1000 : permille, 0 };
+}
+
+// Walks each site's arms in order, subtracting what earlier arms took
+static void compute_hints(unsigned long long min_reach) {
+    for (int i = 0; i < nrecords; ) {
+        int end = i + 1;
+        while (end < nrecords && same_site(&records[i], &records[end])) end++;
+
+        unsigned long long reach = 0;
+        int first = i;
+        if (records[i].index < 0) {
+            reach = records[i].hits;
+            first = i + 1;
+        } else {
+            // Profiles without site records: assume every run took an arm
+            for (int k = i; k < end; k++) reach += records[k].hits;
+        }
+        for (int k = first; k < end; k++) {
+            if (hintable(&records[k]) && reach >= min_reach && reach > 0) add_hint(&records[k], reach);
+            reach -= records[k].hits < reach ? records[k].hits : reach;
+        }
+        i = end;
+    }
+
+    for (int a = 0; a < nhints; a++)
+        for (int b = 0; b < nhints; b++)
+            if (a != b && hints[a].arm->arm_line == hints[b].arm->arm_line) hints[a].shared = 1;
+}
+
+// ============================================================================
+// Emitting Hints
+// ============================================================================
+
+static int compare_hotness(const void *pa, const void *pb) {
+    const Record *a = *(const Record *const *)pa, *b = *(const Record *const *)pb;
+    if (a->hits != b->hits) return a->hits < b->hits ? 1 : -1;
+    return (a->index > b->index) - (a->index < b->index);
+}
+
+// Suggests hottest-first order when the site's when()/is() arms are not in it
+static void emit_order(FILE *out, const Record *arms, int n) {
+    const Record *sorted[n > 0 ? n : 1];
+    int m = 0;
+    for (int k = 0; k < n; k++)
+        if (hintable(&arms[k])) sorted[m++] = &arms[k];
+    qsort(sorted, m, sizeof *sorted, compare_hotness);
+
+    int in_order = 1;
+    for (int k = 0; k < m; k++)
+        if (k > 0 && sorted[k]->index < sorted[k - 1]->index) in_order = 0;
+    if (in_order) return;
+
+    fprintf(out, "// Hottest first:");
+    for (int k = 0; k < m; k++)
+        fprintf(out, "%s arm %d (line %d)", k ? "," : "", sorted[k]->index, sorted[k]->arm_line);
+    fprintf(out, "\n// Reorder by hand only if those arms are disjoint.\n");
+}
+
+static void emit_hints(FILE *out) {
+    int h = 0;
+    for (int i = 0; i < nrecords; ) {
+        int end = i + 1;
+        while (end < nrecords && same_site(&records[i], &records[end])) end++;
+        int first = records[i].index < 0 ? i + 1 : i;
+
+        fprintf(out, "\n// %s:%d %s()", records[i].file, records[i].site_line, records[i].func);
+        if (first > i) fprintf(out, " - entered %llu times", records[i].hits);
+        fprintf(out, "\n");
+        for (; h < nhints && hints[h].arm < &records[end]; h++) {
+            const Hint *hint = &hints[h];
+            char name[32];
+            snprintf(name, sizeof name, "MATCH_HINT_L%d", hint->arm->arm_line);
+            if (hint->shared) {
+                fprintf(out, "// line %d: arm %d shares its line with another arm - no hint\n",
+                        hint->arm->arm_line, hint->arm->index);
+                continue;
+            }
+            fprintf(out, "#define %-20s ~, %-4d  // arm %d %s: %llu of %llu\n", name, hint->permille,
+                    hint->arm->index, hint->arm->kind, hint->arm->hits, hint->reach);
+        }
+        emit_order(out, &records[first], end - first);
+        i = end;
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char **argv) {
+    const char *out_name = NULL, *source = NULL;
+    const char *inputs[MAX_INPUTS];
+    int ninputs = 0;
+    long long min_reach = 100;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_name = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            source = argv[++i];
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            if (!parse_int(argv[++i], &min_reach) || min_reach < 0) die("-m expects a non-negative count");
+        } else if (argv[i][0] == '-' || ninputs == MAX_INPUTS) {
+            fprintf(stderr, "usage: %s profile.tsv [more.tsv ...] [-s source.c] [-m min] [-o hints.h]\n", argv[0]);
+            return 2;
+        } else {
+            inputs[ninputs++] = argv[i];
+        }
+    }
+    if (ninputs == 0) die("no profile given; record one with MATCH_PROFILE_OUT=profile.tsv");
+
+    for (int i = 0; i < ninputs; i++) read_profile(inputs[i]);
+    merge_records();
+    select_source(source);
+    if (nrecords == 0) die(source ? "no records for that source file" : "profile is empty");
+    compute_hints((unsigned long long)min_reach);
+
+    FILE *out = stdout;
+    if (out_name) {
+        out = fopen(out_name, "w");
+        if (!out) { perror(out_name); return 1; }
+    }
+
+    fprintf(out, "// Generated by tools/match_pgo from %s", inputs[0]);
+    for (int i = 1; i < ninputs; i++) fprintf(out, ", %s", inputs[i]);
+    fprintf(out, " - do not edit\n");
+    fprintf(out, "// Branch hints for %s; include before match.h there and nowhere else.\n\n", records[0].file);
+    fprintf(out, "#define MATCH_HINTS\n");
+    emit_hints(out);
+
+    int emitted = 0;
+    for (int i = 0; i < nhints; i++) emitted += !hints[i].shared;
+    fprintf(stderr, "%s: %d hints, %d arm lines shared\n", records[0].file, emitted, nhints - emitted);
+
+    if (out != stdout) fclose(out);
+    return 0;
+}
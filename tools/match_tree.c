@@ -0,0 +1,578 @@
+/*
+ * match_tree - compile multi-argument arm tables into decision trees
+ *
+ * match(a, b, c) { when(...) ... } tests every column of every arm in order,
+ * so N arms over K arguments cost up to K*N compares even when arms share
+ * their leading literals. This tool reads an arm table and emits a plain C
+ * function that tests each argument through nested switch/if nodes instead:
+ * literal columns become one switch, range patterns become one comparison,
+ * and every fact learned on the way down is used to discard arms that can no
+ * longer match. Arm bodies are emitted once and reached with goto.
+ *
+ * Input (one or more tables per file):
+ *
+ *   // Comment lines start with two slashes
+ *   match static int route(int proto, int port, int vlan, int zone, int prio)
+ *   when(6, 80, __, __, __)       { return 1; }
+ *   when(6, 443, __, __, __)      { return 2; }
+ *   when(17, 53, __, 0, __)       { return 3; }
+ *   when(__, __, 100, __, gt(5))  { return 4; }
+ *   otherwise                     { return 0; }
+ *
+ * Patterns are the ones match.h accepts for integer subjects: literals
+ * (numbers, character constants or enum names), __, gt, ge, lt, le, ne,
+ * range and between. First-match semantics are preserved. Distinct literal
+ * spellings in one column are assumed to denote distinct values; the
+ * compiler rejects duplicate case labels if they don't.
+ *
+ * Column order is chosen per node: only columns the first live arm needs
+ * are candidates, preferring the column needed by the longest run of arms
+ * from the top, then the one with the fewest distinct tests, then the
+ * leftmost.
+ *
+ * Usage: match_tree input.match [-o output.h]
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_COLS 10
+#define MAX_ROWS 256
+#define MAX_FACTS 64
+#define MAX_TEXT 256
+
+typedef enum { PAT_WILD, PAT_LIT, PAT_TEST } PatKind;
+
+typedef struct {
+    PatKind kind;
+    char text[MAX_TEXT];   // literal spelling, or the pattern as written
+    int numeric;           // lo/hi (or the ne() value) are known
+    int negated;           // ne(): matches everything but lo
+    long long lo, hi;      // inclusive bounds
+} Pat;
+
+typedef struct {
+    Pat pats[MAX_COLS];
+    char *body;
+    int arm;               // index in source order
+} Row;
+
+typedef enum { RES_FALSE, RES_TRUE, RES_UNKNOWN } Res;
+
+typedef struct {
+    char text[MAX_TEXT];
+    int result;
+} Fact;
+
+// What the path from the root has established about one column
+typedef struct {
+    long long lo, hi;
+    const char *eq;        // literal the column is known to equal, if any
+    Fact facts[MAX_FACTS];
+    int nfacts;
+} Know;
+
+typedef struct {
+    char *signature;
+    char params[MAX_COLS][MAX_TEXT];
+    int ncols;
+    Row rows[MAX_ROWS];
+    int nrows;
+    char *otherwise;
+    int reached[MAX_ROWS + 1];
+    int nodes;
+} Table;
+
+static const char *input_name = "<stdin>";
+static int line_no = 1;
+
+static void die(const char *msg) {
+    fprintf(stderr, "%s:%d: error: %s\n", input_name, line_no, msg);
+    exit(1);
+}
+
+// ============================================================================
+// Parsing
+// ============================================================================
+
+static const char *skip_space(const char *p) {
+    for (;;) {
+        while (isspace((unsigned char)*p)) {
+            if (*p == '\n') line_no++;
+            p++;
+        }
+        if (p[0] == '/' && p[1] == '/') {
+            while (*p && *p != '\n') p++;
+            continue;
+        }
+        return p;
+    }
+}
+
+static char *dup_range(const char *start, const char *end) {
+    while (start < end && isspace((unsigned char)*start)) start++;
+    while (end > start && isspace((unsigned char)end[-1])) end--;
+    char *s = malloc((size_t)(end - start) + 1);
+    if (!s) die("out of memory");
+    memcpy(s, start, (size_t)(end - start));
+    s[end - start] = '\0';
+    return s;
+}
+
+// Skips a string or character literal starting at p
+static const char *skip_quoted(const char *p) {
+    char quote = *p++;
+    while (*p && *p != quote) {
+        if (*p == '\\' && p[1]) p++;
+        if (*p == '\n') line_no++;
+        p++;
+    }
+    if (!*p) die("unterminated literal");
+    return p + 1;
+}
+
+// Returns a pointer just past the bracket matching the one at p
+static const char *skip_balanced(const char *p, char open, char close) {
+    int depth = 0;
+    while (*p) {
+        if (*p == '"' || *p == '\'') { p = skip_quoted(p); continue; }
+        if (*p == '\n') line_no++;
+        if (*p == open) depth++;
+        else if (*p == close && --depth == 0) return p + 1;
+        p++;
+    }
+    die("unbalanced brackets");
+    return p;
+}
+
+static int parse_number(const char *s, long long *out) {
+    if (s[0] == '\'') {
+        if (s[1] == '\\') {
+            static const char esc[][2] = {
+                { 'n', '\n' }, { 't', '\t' }, { 'r', '\r' }, { '0', '\0' },
+                { '\\', '\\' }, { '\'', '\'' }, { '"', '"' }
+            };
+            for (size_t i = 0; i < sizeof(esc) / sizeof(esc[0]); i++)
+                if (s[2] == esc[i][0] && s[3] == '\'' && !s[4]) { *out = (unsigned char)esc[i][1]; return 1; }
+            return 0;
+        }
+        if (s[1] && s[2] == '\'' && !s[3]) { *out = (unsigned char)s[1]; return 1; }
+        return 0;
+    }
+    char *end;
+    errno = 0;
+    long long v = strtoll(s, &end, 0);
+    if (end == s || errno) return 0;
+    while (*end == 'u' || *end == 'U' || *end == 'l' || *end == 'L') end++;
+    if (*end) return 0;
+    *out = v;
+    return 1;
+}
+
+// Splits "a, b, c" at top-level commas
+static int split_args(char *s, char **out, int max) {
+    int n = 0, depth = 0;
+    char *start = s;
+    for (char *p = s; ; p++) {
+        if (*p == '"' || *p == '\'') { p = (char*)skip_quoted(p) - 1; continue; }
+        if (*p == '(') depth++;
+        else if (*p == ')') depth--;
+        if ((*p == ',' && depth == 0) || !*p) {
+            if (n == max) die("too many arguments");
+            int last = !*p;
+            *p = '\0';
+            out[n++] = dup_range(start, p);
+            if (last) break;
+            start = p + 1;
+        }
+    }
+    return n;
+}
+
+static void parse_pattern(const char *src, Pat *pat) {
+    memset(pat, 0, sizeof(*pat));
+    if (strlen(src) >= MAX_TEXT) die("pattern too long");
+    strcpy(pat->text, src);
+    if (strcmp(src, "__") == 0) { pat->kind = PAT_WILD; return; }
+
+    static const char *names[] = { "gt", "ge", "lt", "le", "ne", "range", "between" };
+    for (int k = 0; k < 7; k++) {
+        size_t len = strlen(names[k]);
+        if (strncmp(src, names[k], len) != 0) continue;
+        const char *q = src + len;
+        while (isspace((unsigned char)*q)) q++;
+        if (*q != '(') continue;
+
+        char *inner = dup_range(q + 1, src + strlen(src) - 1);
+        char *args[2];
+        int nargs = split_args(inner, args, 2);
+        if (nargs != (k >= 5 ? 2 : 1)) die("wrong number of pattern arguments");
+        long long a = 0, b = 0;
+        pat->kind = PAT_TEST;
+        pat->numeric = parse_number(args[0], &a) && (nargs < 2 || parse_number(args[1], &b));
+        pat->lo = LLONG_MIN;
+        pat->hi = LLONG_MAX;
+        if (pat->numeric) {
+            switch (k) {
+                case 0: if (a == LLONG_MAX) pat->lo = 1, pat->hi = 0; else pat->lo = a + 1; break;
+                case 1: pat->lo = a; break;
+                case 2: if (a == LLONG_MIN) pat->lo = 1, pat->hi = 0; else pat->hi = a - 1; break;
+                case 3: pat->hi = a; break;
+                case 4: pat->negated = 1; pat->lo = pat->hi = a; break;
+                case 5: pat->lo = a + 1; pat->hi = b - 1; break;
+                case 6: pat->lo = a; pat->hi = b; break;
+            }
+        }
+        free(inner);
+        for (int i = 0; i < nargs; i++) free(args[i]);
+        return;
+    }
+
+    pat->kind = PAT_LIT;
+    pat->numeric = parse_number(src, &pat->lo);
+    pat->hi = pat->lo;
+}
+
+// Reads a "{ ... }" body at p
+static char *parse_body(const char **pp) {
+    const char *p = skip_space(*pp);
+    if (*p != '{') die("expected '{' to start an arm body");
+    const char *end = skip_balanced(p, '{', '}');
+    *pp = end;
+    return dup_range(p, end);
+}
+
+static void parse_signature(Table *t, const char *start, const char *end) {
+    t->signature = dup_range(start, end);
+    const char *open = strchr(t->signature, '(');
+    if (!open) die("expected a parameter list after match");
+    char *list = dup_range(open + 1, t->signature + strlen(t->signature) - 1);
+    char *params[MAX_COLS];
+    t->ncols = split_args(list, params, MAX_COLS);
+    for (int i = 0; i < t->ncols; i++) {
+        // The parameter name is the last identifier in the declaration
+        const char *e = params[i] + strlen(params[i]);
+        while (e > params[i] && !(isalnum((unsigned char)e[-1]) || e[-1] == '_')) e--;
+        const char *s = e;
+        while (s > params[i] && (isalnum((unsigned char)s[-1]) || s[-1] == '_')) s--;
+        if (s == e || e - s >= MAX_TEXT) die("cannot find parameter name");
+        memcpy(t->params[i], s, (size_t)(e - s));
+        t->params[i][e - s] = '\0';
+        free(params[i]);
+    }
+    free(list);
+}
+
+// Parses one table starting at "match"; returns 0 at end of input
+static int parse_table(const char **pp, Table *t) {
+    const char *p = skip_space(*pp);
+    if (!*p) return 0;
+    if (strncmp(p, "match", 5) != 0 || !isspace((unsigned char)p[5])) die("expected 'match'");
+
+    memset(t, 0, sizeof(*t));
+    const char *sig = p + 5;
+    const char *open = strchr(sig, '(');
+    if (!open) die("expected a parameter list after match");
+    p = skip_balanced(open, '(', ')');
+    parse_signature(t, sig, p);
+
+    for (;;) {
+        p = skip_space(p);
+        if (strncmp(p, "when", 4) == 0 && (p[4] == '(' || isspace((unsigned char)p[4]))) {
+            const char *q = skip_space(p + 4);
+            const char *end = skip_balanced(q, '(', ')');
+            char *inner = dup_range(q + 1, end - 1);
+            char *args[MAX_COLS];
+            int n = split_args(inner, args, MAX_COLS);
+            if (n != t->ncols) die("when() arity does not match the parameter list");
+            if (t->nrows == MAX_ROWS) die("too many arms");
+            Row *row = &t->rows[t->nrows];
+            for (int i = 0; i < n; i++) { parse_pattern(args[i], &row->pats[i]); free(args[i]); }
+            free(inner);
+            p = end;
+            row->body = parse_body(&p);
+            row->arm = t->nrows++;
+        } else if (strncmp(p, "otherwise", 9) == 0) {
+            p += 9;
+            t->otherwise = parse_body(&p);
+        } else {
+            break;
+        }
+    }
+    *pp = p;
+    return 1;
+}
+
+// ============================================================================
+// Decision tree construction
+// ============================================================================
+
+static Res resolve(const Pat *pat, const Know *k) {
+    if (pat->kind == PAT_WILD) return RES_TRUE;
+    for (int i = 0; i < k->nfacts; i++)
+        if (strcmp(k->facts[i].text, pat->text) == 0) return k->facts[i].result ? RES_TRUE : RES_FALSE;
+
+    if (pat->kind == PAT_LIT) {
+        if (k->eq) return strcmp(k->eq, pat->text) == 0 ? RES_TRUE : RES_FALSE;
+        if (pat->numeric) {
+            if (pat->lo < k->lo || pat->lo > k->hi) return RES_FALSE;
+            if (k->lo == k->hi) return RES_TRUE;
+        }
+        return RES_UNKNOWN;
+    }
+    if (!pat->numeric) return RES_UNKNOWN;
+    if (pat->negated) {
+        if (pat->lo < k->lo || pat->lo > k->hi) return RES_TRUE;
+        if (k->lo == k->hi) return RES_FALSE;
+        for (int i = 0; i < k->nfacts; i++) {
+            // default branch of a switch that cased this value
+            long long v;
+            if (!k->facts[i].result && parse_number(k->facts[i].text, &v) && v == pat->lo) return RES_TRUE;
+        }
+        return RES_UNKNOWN;
+    }
+    if (pat->lo > pat->hi || pat->hi < k->lo || pat->lo > k->hi) return RES_FALSE;
+    if (pat->lo <= k->lo && pat->hi >= k->hi) return RES_TRUE;
+    return RES_UNKNOWN;
+}
+
+static void add_fact(Know *k, const char *text, int result) {
+    if (k->nfacts == MAX_FACTS) die("decision tree too deep");
+    strcpy(k->facts[k->nfacts].text, text);
+    k->facts[k->nfacts++].result = result;
+}
+
+static void emit_indent(FILE *out, int depth) {
+    for (int i = 0; i < depth; i++) fputs("    ", out);
+}
+
+static void emit_condition(FILE *out, const char *v, const Pat *pat) {
+    const char *open = strchr(pat->text, '(');
+    const char *name_end = open;
+    while (name_end > pat->text && isspace((unsigned char)name_end[-1])) name_end--;
+    size_t len = (size_t)(name_end - pat->text);
+    char *inner = dup_range(open + 1, pat->text + strlen(pat->text) - 1);
+    char *args[2];
+    int n = split_args(inner, args, 2);
+    static const char *ops[][2] = { { "gt", ">" }, { "ge", ">=" }, { "lt", "<" }, { "le", "<=" }, { "ne", "!=" } };
+    int done = 0;
+    for (int i = 0; i < 5 && !done; i++) {
+        if (len == strlen(ops[i][0]) && strncmp(pat->text, ops[i][0], len) == 0) {
+            fprintf(out, "%s %s (%s)", v, ops[i][1], args[0]);
+            done = 1;
+        }
+    }
+    if (!done && len == 5) fprintf(out, "%s > (%s) && %s < (%s)", v, args[0], v, args[1]);
+    else if (!done) fprintf(out, "%s >= (%s) && %s <= (%s)", v, args[0], v, args[1]);
+    for (int i = 0; i < n; i++) free(args[i]);
+    free(inner);
+}
+
+static void compile(FILE *out, Table *t, const int *live, int nlive, Know *know, int depth);
+
+static void compile_child(FILE *out, Table *t, const int *live, int nlive, Know *know, int depth) {
+    int next[MAX_ROWS];
+    int n = 0;
+    for (int i = 0; i < nlive; i++) {
+        const Row *row = &t->rows[live[i]];
+        int keep = 1;
+        for (int c = 0; c < t->ncols && keep; c++)
+            if (resolve(&row->pats[c], &know[c]) == RES_FALSE) keep = 0;
+        if (keep) next[n++] = live[i];
+    }
+    compile(out, t, next, n, know, depth);
+}
+
+static void compile(FILE *out, Table *t, const int *live, int nlive, Know *know, int depth) {
+    if (nlive == 0) {
+        t->reached[t->nrows] = 1;
+        emit_indent(out, depth);
+        fputs(t->otherwise ? "goto match_otherwise;\n" : "goto match_done;\n", out);
+        return;
+    }
+
+    // Pick the column: needed by the first live arm, longest needed prefix,
+    // fewest distinct tests, leftmost
+    const Row *first = &t->rows[live[0]];
+    int best = -1, best_prefix = 0, best_tests = 0;
+    for (int c = 0; c < t->ncols; c++) {
+        if (resolve(&first->pats[c], &know[c]) != RES_UNKNOWN) continue;
+        int prefix = 0;
+        while (prefix < nlive && resolve(&t->rows[live[prefix]].pats[c], &know[c]) == RES_UNKNOWN) prefix++;
+        int tests = 0;
+        for (int i = 0; i < nlive; i++) {
+            const Pat *pat = &t->rows[live[i]].pats[c];
+            if (resolve(pat, &know[c]) != RES_UNKNOWN) continue;
+            int seen = 0;
+            for (int j = 0; j < i && !seen; j++)
+                seen = strcmp(t->rows[live[j]].pats[c].text, pat->text) == 0;
+            tests += !seen;
+        }
+        if (best < 0 || prefix > best_prefix || (prefix == best_prefix && tests < best_tests)) {
+            best = c;
+            best_prefix = prefix;
+            best_tests = tests;
+        }
+    }
+
+    if (best < 0) {
+        t->reached[first->arm] = 1;
+        emit_indent(out, depth);
+        fprintf(out, "goto match_arm_%d;\n", first->arm);
+        return;
+    }
+
+    t->nodes++;
+    const char *v = t->params[best];
+    Know saved = know[best];
+    const Pat *head = &first->pats[best];
+
+    if (head->kind == PAT_LIT) {
+        // One switch over every literal still possible in this column
+        const char *lits[MAX_ROWS];
+        int nlits = 0;
+        for (int i = 0; i < nlive; i++) {
+            const Pat *pat = &t->rows[live[i]].pats[best];
+            if (pat->kind != PAT_LIT || resolve(pat, &saved) != RES_UNKNOWN) continue;
+            int seen = 0;
+            for (int j = 0; j < nlits && !seen; j++) seen = strcmp(lits[j], pat->text) == 0;
+            if (!seen) lits[nlits++] = pat->text;
+        }
+
+        emit_indent(out, depth);
+        fprintf(out, "switch (%s) {\n", v);
+        for (int j = 0; j < nlits; j++) {
+            const Pat *lit = NULL;
+            for (int i = 0; i < nlive && !lit; i++)
+                if (strcmp(t->rows[live[i]].pats[best].text, lits[j]) == 0) lit = &t->rows[live[i]].pats[best];
+            know[best] = saved;
+            know[best].eq = lits[j];
+            if (lit->numeric) know[best].lo = know[best].hi = lit->lo;
+            emit_indent(out, depth);
+            fprintf(out, "case %s:\n", lits[j]);
+            compile_child(out, t, live, nlive, know, depth + 1);
+        }
+        know[best] = saved;
+        for (int j = 0; j < nlits; j++) add_fact(&know[best], lits[j], 0);
+        emit_indent(out, depth);
+        fputs("default:\n", out);
+        compile_child(out, t, live, nlive, know, depth + 1);
+        emit_indent(out, depth);
+        fputs("}\n", out);
+    } else {
+        emit_indent(out, depth);
+        fputs("if (", out);
+        emit_condition(out, v, head);
+        fputs(") {\n", out);
+        know[best] = saved;
+        add_fact(&know[best], head->text, 1);
+        if (head->numeric && !head->negated) {
+            if (head->lo > know[best].lo) know[best].lo = head->lo;
+            if (head->hi < know[best].hi) know[best].hi = head->hi;
+        }
+        compile_child(out, t, live, nlive, know, depth + 1);
+        emit_indent(out, depth);
+        fputs("} else {\n", out);
+        know[best] = saved;
+        add_fact(&know[best], head->text, 0);
+        if (head->numeric && head->negated) {
+            know[best].lo = know[best].hi = head->lo;
+        } else if (head->numeric && head->lo <= know[best].lo && head->hi < know[best].hi) {
+            know[best].lo = head->hi + 1;
+        } else if (head->numeric && head->hi >= know[best].hi && head->lo > know[best].lo) {
+            know[best].hi = head->lo - 1;
+        }
+        compile_child(out, t, live, nlive, know, depth + 1);
+        emit_indent(out, depth);
+        fputs("}\n", out);
+    }
+    know[best] = saved;
+}
+
+static void emit_table(FILE *out, Table *t) {
+    Know know[MAX_COLS];
+    int live[MAX_ROWS];
+    for (int c = 0; c < t->ncols; c++) {
+        memset(&know[c], 0, sizeof(know[c]));
+        know[c].lo = LLONG_MIN;
+        know[c].hi = LLONG_MAX;
+    }
+    for (int i = 0; i < t->nrows; i++) live[i] = i;
+
+    fprintf(out, "%s {\n", t->signature);
+    compile_child(out, t, live, t->nrows, know, 1);
+
+    for (int i = 0; i < t->nrows; i++) {
+        if (!t->reached[i]) {
+            fprintf(stderr, "%s: warning: arm %d of '%s' can never match\n", input_name, i + 1, t->signature);
+            continue;
+        }
+        fprintf(out, "match_arm_%d:\n    %s\n    goto match_done;\n", i, t->rows[i].body);
+    }
+    if (t->otherwise && t->reached[t->nrows])
+        fprintf(out, "match_otherwise:\n    %s\n    goto match_done;\n", t->otherwise);
+    fputs("match_done:\n    ;\n}\n\n", out);
+}
+
+// ============================================================================
+// Driver
+// ============================================================================
+
+static char *read_all(FILE *in) {
+    size_t cap = 4096, len = 0;
+    char *buf = malloc(cap);
+    if (!buf) die("out of memory");
+    size_t n;
+    while ((n = fread(buf + len, 1, cap - len - 1, in)) > 0) {
+        len += n;
+        if (cap - len < 2) {
+            cap *= 2;
+            buf = realloc(buf, cap);
+            if (!buf) die("out of memory");
+        }
+    }
+    buf[len] = '\0';
+    return buf;
+}
+
+int main(int argc, char **argv) {
+    const char *out_name = NULL;
+    FILE *in = stdin;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_name = argv[++i];
+        } else if (argv[i][0] == '-' && argv[i][1]) {
+            fprintf(stderr, "usage: %s [input.match] [-o output.h]\n", argv[0]);
+            return 2;
+        } else {
+            input_name = argv[i];
+            in = fopen(input_name, "r");
+            if (!in) { perror(input_name); return 1; }
+        }
+    }
+
+    char *src = read_all(in);
+    if (in != stdin) fclose(in);
+
+    FILE *out = stdout;
+    if (out_name) {
+        out = fopen(out_name, "w");
+        if (!out) { perror(out_name); return 1; }
+    }
+
+    fprintf(out, "// Generated by tools/match_tree from %s - do not edit\n\n", input_name);
+    static Table table;
+    const char *p = src;
+    while (parse_table(&p, &table)) {
+        emit_table(out, &table);
+        fprintf(stderr, "%s: %s: %d arms, %d test nodes\n", input_name, table.signature, table.nrows, table.nodes);
+    }
+
+    if (out != stdout) fclose(out);
+    free(src);
+    return 0;
+}